@@ -6,16 +6,24 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AuraGameplayTags.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "AbilitySystem/AuraAttributeSet.h"
 #include "AbilitySystem/Abilities/AuraGameplayAbility.h"
 #include "AbilitySystem/Data/AbilityInfo.h"
 #include "AbilitySystem/Skills/SkillDamageGameplayAbility.h"
 #include "AbilitySystem/Skills/SkillTalentTreeData.h"
+#include "Actor/AuraProjectileSpawnSubsystem.h"
+#include "GameFramework/GameStateBase.h"
 #include "Aura/AuraLogChannels.h"
 #include "Interaction/PlayerInterface.h"
+#include "Profiling/AuraAbilityLatencyTracker.h"
+#include "Profiling/AuraNetProfiler.h"
+#include "TimerManager.h"
 
 void UAuraAbilitySystemComponent::AbilityActorInfoSet()
 {
-	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::ClientEffectApplied);
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::OnEffectAppliedToSelf);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UAuraAbilitySystemComponent::OnTalentEffectRemoved);
+	RegisterActivationReadinessEvents();
 }
 
 void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>>& StartupAbilities)
@@ -56,19 +64,25 @@ void UAuraAbilitySystemComponent::AddCharacterPassivesAbilities(const TArray<TSu
 void UAuraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	const FAuraInputSlot* InputSlot = GetInputSlot(InputTag);
+	if (InputSlot == nullptr) return;
+	// A new press always gets a full activation attempt.
+	ActivationNotReadySlots &= ~(1 << GetInputSlotIndex(InputTag));
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	for (const FAuraAbilitySpecIndex& SpecIndex : InputSlot->Specs)
 	{
-		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
+		FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecIndex.Index];
+		AbilitySpecInputPressed(AbilitySpec);
+		if (!AbilitySpec.IsActive())
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (AbilitySpec.IsActive())
-			{
-				// If we are using Wait Input Press/Release in a Gameplay Ability and these tasks don't work, we should check to make sure :
-				// The ABility System Component is using InvokeReplicatedEvent to inform the server of the input.
-				// Todo Rewatch :Invoke Replicated Event
-				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec.Handle, AbilitySpec.ActivationInfo.GetActivationPredictionKey());
-			}
+			FAuraAbilityLatencyTracker::MarkInputPressed(this, GetSpecTags(AbilitySpec).AbilityTag);
+		}
+		else
+		{
+			// If we are using Wait Input Press/Release in a Gameplay Ability and these tasks don't work, we should check to make sure :
+			// The ABility System Component is using InvokeReplicatedEvent to inform the server of the input.
+			// Todo Rewatch :Invoke Replicated Event
+			InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec.Handle, AbilitySpec.ActivationInfo.GetActivationPredictionKey());
 		}
 	}
 }
@@ -76,15 +90,25 @@ void UAuraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Inp
 void UAuraAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	const FAuraInputSlot* InputSlot = GetInputSlot(InputTag);
+	if (InputSlot == nullptr) return;
+	const uint8 SlotBit = 1 << GetInputSlotIndex(InputTag);
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	for (const FAuraAbilitySpecIndex& SpecIndex : InputSlot->Specs)
 	{
-		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
+		FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecIndex.Index];
+		AbilitySpecInputPressed(AbilitySpec);
+		if (!AbilitySpec.IsActive() && (ActivationNotReadySlots & SlotBit) == 0)
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (!AbilitySpec.IsActive())
+			// Same source as TryActivateAbility for the checks, without sending anything to the server when it fails.
+			const UGameplayAbility* AbilitySource = AbilitySpec.GetPrimaryInstance() ? AbilitySpec.GetPrimaryInstance() : AbilitySpec.Ability.Get();
+			if (AbilitySource && AbilitySource->CanActivateAbility(AbilitySpec.Handle, AbilityActorInfo.Get()))
+			{
+				TryActivateAbility(AbilitySpec.Handle);
+			}
+			else
 			{
-			   TryActivateAbility(AbilitySpec.Handle);
+				ActivationNotReadySlots |= SlotBit;
 			}
 		}
 	}
@@ -93,10 +117,13 @@ void UAuraAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputT
 void UAuraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
 {
 	if (!InputTag.IsValid()) return;
+	const FAuraInputSlot* InputSlot = GetInputSlot(InputTag);
+	if (InputSlot == nullptr) return;
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	for (const FAuraAbilitySpecIndex& SpecIndex : InputSlot->Specs)
 	{
-		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag) && AbilitySpec.IsActive())
+		FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecIndex.Index];
+		if (AbilitySpec.IsActive())
 		{
 			AbilitySpecInputReleased(AbilitySpec);
 			// Necessary for WaitInputReleased in Blueprint. it is a predicted action and it needs the original prediction key.
@@ -115,23 +142,26 @@ void UAuraAbilitySystemComponent::ForEachAbility(const FForEachAbilitySignature&
 	// before going further and mutating that list.
 	
 	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (const FGameplayAbilitySpec AbilitySpec : GetActivatableAbilities())
+	if (!Delegate.IsBound())
+	{
+		UE_LOG(LogAura, Error, TEXT("Failed to execute delegate in %hs"), __FUNCTION__);
+		return;
+	}
+	for (const FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
 	{
 		//Bound in UOverlayWidgetController::BroadcastAbilityInfo
-		if (!Delegate.ExecuteIfBound(AbilitySpec))
-		{
-			UE_LOG(LogAura, Error, TEXT("Failed to execute delegate in %hs"), __FUNCTION__);
-		}
+		Delegate.Execute(AbilitySpec);
 	}
 }
 
 FGameplayTag UAuraAbilitySystemComponent::GetAbilityTagFromSpec(const FGameplayAbilitySpec& AbilitySpec)
 {
+	static const FGameplayTag AbilitiesTag = FGameplayTag::RequestGameplayTag(FName("Abilities"));
 	if (AbilitySpec.Ability)
 	{
-		for (FGameplayTag Tag : AbilitySpec.Ability.Get()->AbilityTags)
+		for (const FGameplayTag& Tag : AbilitySpec.Ability.Get()->AbilityTags)
 		{
-			if (Tag.MatchesTag(FGameplayTag::RequestGameplayTag(FName("Abilities"))))
+			if (Tag.MatchesTag(AbilitiesTag))
 			{
 				return Tag;
 			}
@@ -142,9 +172,10 @@ FGameplayTag UAuraAbilitySystemComponent::GetAbilityTagFromSpec(const FGameplayA
 
 FGameplayTag UAuraAbilitySystemComponent::GetInputTagFromSpec(const FGameplayAbilitySpec& AbilitySpec)
 {
-	for (FGameplayTag Tag : AbilitySpec.DynamicAbilityTags)
+	static const FGameplayTag InputTag = FGameplayTag::RequestGameplayTag(FName("InputTag"));
+	for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
 	{
-		if (Tag.MatchesTag(FGameplayTag::RequestGameplayTag(FName("InputTag"))))
+		if (Tag.MatchesTag(InputTag))
 		{
 			return Tag;
 		}
@@ -154,9 +185,10 @@ FGameplayTag UAuraAbilitySystemComponent::GetInputTagFromSpec(const FGameplayAbi
 
 FGameplayTag UAuraAbilitySystemComponent::GetStatusFromSpec(const FGameplayAbilitySpec& AbilitySpec)
 {
-	for (FGameplayTag StatusTag : AbilitySpec.DynamicAbilityTags)
+	static const FGameplayTag AbilitiesStatusTag = FGameplayTag::RequestGameplayTag(FName("Abilities.Status"));
+	for (const FGameplayTag& StatusTag : AbilitySpec.DynamicAbilityTags)
 	{
-		if (StatusTag.MatchesTag(FGameplayTag::RequestGameplayTag(FName("Abilities.Status"))))
+		if (StatusTag.MatchesTag(AbilitiesStatusTag))
 		{
 			return StatusTag;
 		}
@@ -168,7 +200,7 @@ FGameplayTag UAuraAbilitySystemComponent::GetStatusFromAbilityTag(const FGamepla
 {
 	if (const FGameplayAbilitySpec* Spec = GetSpecFromAbilityTag(AbilityTag))
 	{
-		return GetStatusFromSpec(*Spec);
+		return GetSpecTags(*Spec).StatusTag;
 	}
 	return FGameplayTag();
 }
@@ -177,22 +209,15 @@ FGameplayTag UAuraAbilitySystemComponent::GetSlotFromAbilityTag(const FGameplayT
 {
 	if (const FGameplayAbilitySpec* Spec = GetSpecFromAbilityTag(AbilityTag))
 	{
-		return GetInputTagFromSpec(*Spec);
+		return GetSpecTags(*Spec).InputTag;
 	}
 	return FGameplayTag();
 }
 
 bool UAuraAbilitySystemComponent::SlotIsEmpty(const FGameplayTag& Slot)
 {
-	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
-	{
-		if (AbilityHasSlot(AbilitySpec, Slot))
-		{
-			return false;
-		}
-	}
-	return true;
+	const FAuraInputSlot* InputSlot = GetInputSlot(Slot);
+	return InputSlot == nullptr || InputSlot->Specs.IsEmpty();
 }
 
 bool UAuraAbilitySystemComponent::AbilityHasSlot(const FGameplayAbilitySpec& Spec, const FGameplayTag& Slot)
@@ -202,35 +227,66 @@ bool UAuraAbilitySystemComponent::AbilityHasSlot(const FGameplayAbilitySpec& Spe
 
 bool UAuraAbilitySystemComponent::AbilityHasAnySlot(const FGameplayAbilitySpec& Spec)
 {
-	return Spec.DynamicAbilityTags.HasTag(FGameplayTag::RequestGameplayTag(FName("InputTag")));
+	static const FGameplayTag InputTag = FGameplayTag::RequestGameplayTag(FName("InputTag"));
+	return Spec.DynamicAbilityTags.HasTag(InputTag);
 }
 
 FGameplayAbilitySpec* UAuraAbilitySystemComponent::GetSpecWithSlot(const FGameplayTag& Slot)
 {
-	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	const FAuraInputSlot* InputSlot = GetInputSlot(Slot);
+	if (InputSlot == nullptr || InputSlot->Specs.IsEmpty()) return nullptr;
+	return &ActivatableAbilities.Items[InputSlot->Specs[0].Index];
+}
+
+bool UAuraAbilitySystemComponent::IsPassiveAbility(const FGameplayAbilitySpec& Spec) const
+{
+	return GetSpecTags(Spec).bIsPassive;
+}
+
+FAuraAbilitySpecTags UAuraAbilitySystemComponent::GetSpecTags(const FGameplayAbilitySpec& Spec) const
+{
+	// Specs marked dirty by any code, the engine included, are resolved again.
+	const FAuraAbilitySpecTags* CachedTags = SpecTagsCache.Find(Spec.Handle);
+	if (CachedTags && CachedTags->SpecReplicationKey == Spec.ReplicationKey)
 	{
-		if (AbilityHasSlot(AbilitySpec, Slot))
-		{
-			return &AbilitySpec;
-		}
+		return *CachedTags;
 	}
-	return nullptr;
+
+	static const FGameplayTag AbilitiesPassiveTag = FGameplayTag::RequestGameplayTag(FName("Abilities.Passive"));
+	FAuraAbilitySpecTags SpecTags;
+	SpecTags.AbilityTag = GetAbilityTagFromSpec(Spec);
+	SpecTags.InputTag = GetInputTagFromSpec(Spec);
+	SpecTags.StatusTag = GetStatusFromSpec(Spec);
+	// From the ability tags rather than the ability info, which only exists with the GameMode on the server.
+	SpecTags.bIsPassive = SpecTags.AbilityTag.MatchesTag(AbilitiesPassiveTag);
+	SpecTags.SpecReplicationKey = Spec.ReplicationKey;
+	SpecTagsCache.Add(Spec.Handle, SpecTags);
+	return SpecTags;
 }
 
-bool UAuraAbilitySystemComponent::IsPassiveAbility(const FGameplayAbilitySpec& Spec) const
+void UAuraAbilitySystemComponent::MarkSpecDirty(FGameplayAbilitySpec& Spec, bool bWasAddOrRemove)
 {
-	const UAbilityInfo* AbilityInfo = UAuraAbilitySystemLibrary::GetAbilityInfo(GetAvatarActor());
-	const FGameplayTag AbilityTag = GetAbilityTagFromSpec(Spec);
-	const FAuraAbilityInfo& Info = AbilityInfo->FindAbilityInfoForTag(AbilityTag);
-	const FGameplayTag AbilityType = Info.AbilityType;
-	return AbilityType.MatchesTagExact(FAuraGameplayTags::Get().Abilities_Type_Passive);
+	InvalidateSpecTags(Spec);
+	MarkAbilitySpecDirty(Spec, bWasAddOrRemove);
 }
 
 void UAuraAbilitySystemComponent::AssignSlotToAbility(FGameplayAbilitySpec& Spec, const FGameplayTag& Slot)
 {
 	ClearSlot(&Spec);
 	Spec.DynamicAbilityTags.AddTag(Slot);
+	InvalidateSpecTags(Spec);
+
+	ResetActivationReadiness();
+	const int32 SlotIndex = GetInputSlotIndex(Slot);
+	const int32 SpecIndex = GetAbilitySpecIndex(Spec);
+	if (!bInputSlotsDirty && SlotIndex != INDEX_NONE && SpecIndex != INDEX_NONE)
+	{
+		InputSlots[SlotIndex].Specs.Add({Spec.Handle, SpecIndex});
+	}
+	else
+	{
+		bInputSlotsDirty = true;
+	}
 }
 
 void UAuraAbilitySystemComponent::MultiCastActivatePassiveEffect_Implementation(const FGameplayTag& AbilityTag,	bool bActivate)
@@ -238,21 +294,203 @@ void UAuraAbilitySystemComponent::MultiCastActivatePassiveEffect_Implementation(
 	ActivatePassiveEffectDelegate.Broadcast(AbilityTag, bActivate);
 }
 
+void UAuraAbilitySystemComponent::MulticastProjectileVolley_Implementation(const FAuraProjectileVolley& Volley)
+{
+	// The server already spawned the real bolts.
+	if (IsOwnerActorAuthoritative()) return;
+
+	AActor* AvatarActor = GetAvatarActor();
+	UAuraProjectileSpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UAuraProjectileSpawnSubsystem>();
+	if (AvatarActor == nullptr || SpawnSubsystem == nullptr) return;
+
+	FAuraProjectileSpawnRequest Template;
+	Template.ProjectileClass = Volley.ProjectileClass;
+	Template.Owner = AvatarActor;
+	Template.Instigator = Cast<APawn>(AvatarActor);
+	Template.bReplicates = false;
+	Template.bSimulateInBatch = true;
+	Template.VolleyId = Volley.VolleyId;
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		Template.LaunchDelay = FMath::Max(0.f, GameState->GetServerWorldTimeSeconds() - Volley.ServerTime);
+	}
+	SpawnSubsystem->SpawnVolley(Volley, Template);
+}
+
+void UAuraAbilitySystemComponent::MulticastProjectileImpact_Implementation(uint16 VolleyId, uint8 BoltIndex, FVector_NetQuantize ImpactLocation)
+{
+	if (IsOwnerActorAuthoritative()) return;
+
+	if (UAuraProjectileSpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UAuraProjectileSpawnSubsystem>())
+	{
+		SpawnSubsystem->StopVolleyBolt(GetAvatarActor(), VolleyId, BoltIndex, ImpactLocation);
+	}
+}
+
+uint16 UAuraAbilitySystemComponent::MakeProjectileVolleyId()
+{
+	// 0 means no volley.
+	LastProjectileVolleyId = LastProjectileVolleyId == MAX_uint16 ? 1 : LastProjectileVolleyId + 1;
+	return LastProjectileVolleyId;
+}
+
 FGameplayAbilitySpec* UAuraAbilitySystemComponent::GetSpecFromAbilityTag(const FGameplayTag& AbilityTag)
 {
-	// We create a scoped ability list lock.
-	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	if (bAbilityTagMapDirty)
+	{
+		RebuildAbilityTagMap();
+	}
+
+	TArray<FGameplayAbilitySpec>& Specs = ActivatableAbilities.Items;
+	const FAuraAbilitySpecIndex* SpecIndex = AbilityTagToSpec.Find(AbilityTag);
+	if (SpecIndex && Specs.IsValidIndex(SpecIndex->Index) && Specs[SpecIndex->Index].Handle == SpecIndex->Handle)
 	{
-		for (FGameplayTag Tag : AbilitySpec.Ability.Get()->AbilityTags)
+		return &Specs[SpecIndex->Index];
+	}
+	if (SpecIndex == nullptr) return nullptr;
+
+	// The list was reordered without going through OnGiveAbility/OnRemoveAbility.
+	RebuildAbilityTagMap();
+	SpecIndex = AbilityTagToSpec.Find(AbilityTag);
+	return SpecIndex ? &Specs[SpecIndex->Index] : nullptr;
+}
+
+void UAuraAbilitySystemComponent::IndexAbilitySpec(const FGameplayAbilitySpec& AbilitySpec, int32 Index)
+{
+	if (AbilitySpec.Ability == nullptr) return;
+
+	// GetSpecFromAbilityTag matches hierarchically, so a spec is also found from the parents of its tags.
+	for (const FGameplayTag& Tag : AbilitySpec.Ability->AbilityTags)
+	{
+		for (const FGameplayTag& ParentTag : Tag.GetGameplayTagParents())
+		{
+			if (!AbilityTagToSpec.Contains(ParentTag))
+			{
+				AbilityTagToSpec.Add(ParentTag, {AbilitySpec.Handle, Index});
+			}
+		}
+	}
+}
+
+void UAuraAbilitySystemComponent::RebuildAbilityTagMap()
+{
+	AbilityTagToSpec.Reset();
+	const TArray<FGameplayAbilitySpec>& Specs = ActivatableAbilities.Items;
+	for (int32 i = 0; i < Specs.Num(); i++)
+	{
+		IndexAbilitySpec(Specs[i], i);
+	}
+	bAbilityTagMapDirty = false;
+}
+
+void UAuraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	// New specs are appended, they can be indexed without rebuilding the map.
+	const int32 Index = GetAbilitySpecIndex(AbilitySpec);
+	if (!bAbilityTagMapDirty && Index != INDEX_NONE)
+	{
+		IndexAbilitySpec(AbilitySpec, Index);
+	}
+	else
+	{
+		bAbilityTagMapDirty = true;
+	}
+	bInputSlotsDirty = true;
+}
+
+void UAuraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnRemoveAbility(AbilitySpec);
+	// Removal swaps the last spec in place of the removed one.
+	InvalidateSpecTags(AbilitySpec);
+	bAbilityTagMapDirty = true;
+	bInputSlotsDirty = true;
+	// The removed ability may be in the schedule before the cursor, it has to be given again on the next level up.
+	UnlockCursor = 0;
+}
+
+int32 UAuraAbilitySystemComponent::GetAbilitySpecIndex(const FGameplayAbilitySpec& AbilitySpec) const
+{
+	const TArray<FGameplayAbilitySpec>& Specs = ActivatableAbilities.Items;
+	const int32 Index = UE_PTRDIFF_TO_INT32(&AbilitySpec - Specs.GetData());
+	return Specs.IsValidIndex(Index) ? Index : INDEX_NONE;
+}
+
+int32 UAuraAbilitySystemComponent::GetInputSlotIndex(const FGameplayTag& InputTag)
+{
+	// Input tags are contiguous in EAuraGameplayTag, in the order of the slots.
+	constexpr int32 FirstSlotTag = static_cast<int32>(EAuraGameplayTag::InputTag_LMB);
+	static_assert(static_cast<int32>(EAuraGameplayTag::InputTag_Passive_2) - FirstSlotTag + 1 == NumInputSlots, "Every input slot needs its input tag.");
+
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+	for (int32 i = 0; i < NumInputSlots; i++)
+	{
+		if (GameplayTags.GetTag(static_cast<EAuraGameplayTag>(FirstSlotTag + i)) == InputTag)
 		{
-			if (Tag.MatchesTag(AbilityTag))
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+const FAuraInputSlot* UAuraAbilitySystemComponent::GetInputSlot(const FGameplayTag& InputTag)
+{
+	const int32 SlotIndex = GetInputSlotIndex(InputTag);
+	if (SlotIndex == INDEX_NONE) return nullptr;
+
+	if (!bInputSlotsDirty)
+	{
+		const TArray<FGameplayAbilitySpec>& Specs = ActivatableAbilities.Items;
+		for (const FAuraAbilitySpecIndex& SpecIndex : InputSlots[SlotIndex].Specs)
+		{
+			if (!Specs.IsValidIndex(SpecIndex.Index) || Specs[SpecIndex.Index].Handle != SpecIndex.Handle)
 			{
-				return &AbilitySpec;
+				bInputSlotsDirty = true;
+				break;
 			}
 		}
 	}
-	return nullptr;
+	if (bInputSlotsDirty)
+	{
+		RebuildInputSlots();
+	}
+	return &InputSlots[SlotIndex];
+}
+
+void UAuraAbilitySystemComponent::RebuildInputSlots()
+{
+	for (FAuraInputSlot& InputSlot : InputSlots)
+	{
+		InputSlot.Specs.Reset();
+	}
+
+	const TArray<FGameplayAbilitySpec>& Specs = ActivatableAbilities.Items;
+	for (int32 i = 0; i < Specs.Num(); i++)
+	{
+		for (const FGameplayTag& Tag : Specs[i].DynamicAbilityTags)
+		{
+			const int32 SlotIndex = GetInputSlotIndex(Tag);
+			if (SlotIndex != INDEX_NONE)
+			{
+				InputSlots[SlotIndex].Specs.Add({Specs[i].Handle, i});
+			}
+		}
+	}
+	bInputSlotsDirty = false;
+	ResetActivationReadiness();
+}
+
+void UAuraAbilitySystemComponent::RegisterActivationReadinessEvents()
+{
+	// Parent tags, their count changes with any of their children.
+	RegisterGameplayTagEvent(FGameplayTag::RequestGameplayTag(FName("Cooldown")), EGameplayTagEventType::AnyCountChange).AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessTagChanged);
+	RegisterGameplayTagEvent(FGameplayTag::RequestGameplayTag(FName("Player.Block")), EGameplayTagEventType::AnyCountChange).AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessTagChanged);
+	GetGameplayAttributeValueChangeDelegate(UAuraAttributeSet::GetManaAttribute()).AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessManaChanged);
+	AbilityEndedCallbacks.AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessAbilityEnded);
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessEffectApplied);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UAuraAbilitySystemComponent::OnReadinessEffectRemoved);
 }
 
 void UAuraAbilitySystemComponent::UpgradeAttribute(const FGameplayTag& AttributeTag)
@@ -269,26 +507,64 @@ void UAuraAbilitySystemComponent::UpgradeAttribute(const FGameplayTag& Attribute
 void UAuraAbilitySystemComponent::UpdateAbilityStatuses(int32 Level)
 {
 	UAbilityInfo* AbilityInfo = UAuraAbilitySystemLibrary::GetAbilityInfo(GetAvatarActor());
-	for (const FAuraAbilityInfo& Info : AbilityInfo->AbilitiesInformations)
+	if (AbilityInfo == nullptr) return;
+	if (UnlockScheduleSource.Get() != AbilityInfo)
+	{
+		BuildUnlockSchedule(AbilityInfo);
+	}
+	else if (Level < UnlockScheduleLevel)
 	{
-		if (!Info.AbilityTag.IsValid()) continue;
-		// We need to check its level requirement.
-		if (Level < Info.LevelRequirement) continue;
+		UnlockCursor = 0;
+	}
+	UnlockScheduleLevel = Level;
+
+	// One RPC for every ability unlocked by the level up, even when several levels are gained at once.
+	FAuraScopedAbilityUpdate AbilityUpdate(*this);
+	const FGameplayTag& EligibleTag = FAuraGameplayTags::Get().Abilities_Status_Eligible;
+	for (; UnlockCursor < UnlockSchedule.Num(); UnlockCursor++)
+	{
+		const FAuraAbilityInfo& Info = AbilityInfo->AbilitiesInformations[UnlockSchedule[UnlockCursor]];
+		// We need to check its level requirement, the next ones in the schedule need even more.
+		if (Level < Info.LevelRequirement) break;
 
 		// Not nullptr, we already have it in our activable abilities.
 		// If nullptr,  we have stumbled across an ability that is not already in our ability system component activable abilities.
 		if (GetSpecFromAbilityTag(Info.AbilityTag) == nullptr)
 		{
 			FGameplayAbilitySpec AbilitySpec = FGameplayAbilitySpec(Info.Ability, 1);
-			AbilitySpec.DynamicAbilityTags.AddTag(FAuraGameplayTags::Get().Abilities_Status_Eligible);
-			GiveAbility(AbilitySpec);
+			AbilitySpec.DynamicAbilityTags.AddTag(EligibleTag);
+			const FGameplayAbilitySpecHandle AbilitySpecHandle = GiveAbility(AbilitySpec);
 			// As soon as we add an ability and change something on that ability, there is a way to force it to replicate right away
-			MarkAbilitySpecDirty(AbilitySpec);
-			ClientUpdateAbilityStatus(Info.AbilityTag, FAuraGameplayTags::Get().Abilities_Status_Eligible, 1);
+			if (FGameplayAbilitySpec* GivenAbilitySpec = FindAbilitySpecFromHandle(AbilitySpecHandle))
+			{
+				QueueSpecDirty(*GivenAbilitySpec);
+			}
+			QueueAbilityStatusUpdate(Info.AbilityTag, EligibleTag, 1);
 		}
 	}
 }
 
+void UAuraAbilitySystemComponent::BuildUnlockSchedule(const UAbilityInfo* AbilityInfo)
+{
+	UnlockScheduleSource = AbilityInfo;
+	UnlockCursor = 0;
+	UnlockSchedule.Reset();
+
+	const TArray<FAuraAbilityInfo>& Informations = AbilityInfo->AbilitiesInformations;
+	for (int32 i = 0; i < Informations.Num(); i++)
+	{
+		if (Informations[i].AbilityTag.IsValid())
+		{
+			UnlockSchedule.Add(i);
+		}
+	}
+	// Stable, abilities with the same requirement are given in the asset order.
+	UnlockSchedule.StableSort([&Informations](const int32 A, const int32 B)
+	{
+		return Informations[A].LevelRequirement < Informations[B].LevelRequirement;
+	});
+}
+
 void UAuraAbilitySystemComponent::ServerSpendSpellPoint_Implementation(const FGameplayTag& AbilityTag)
 {
 	//We need to know the status of the ability we're trying to spend a point on.
@@ -299,8 +575,8 @@ void UAuraAbilitySystemComponent::ServerSpendSpellPoint_Implementation(const FGa
 			IPlayerInterface::Execute_AddToSpellPoints(GetAvatarActor(), -1);
 		}
 		
-		const FAuraGameplayTags GameplayTags = FAuraGameplayTags::Get();
-		FGameplayTag Status = GetStatusFromSpec(*AbilitySpec);
+		const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+		FGameplayTag Status = GetSpecTags(*AbilitySpec).StatusTag;
 		if (Status.MatchesTagExact(GameplayTags.Abilities_Status_Eligible))
 		{
 			AbilitySpec->DynamicAbilityTags.RemoveTag(GameplayTags.Abilities_Status_Eligible);
@@ -311,8 +587,9 @@ void UAuraAbilitySystemComponent::ServerSpendSpellPoint_Implementation(const FGa
 		{
 			AbilitySpec->Level += 1;
 		}
-		ClientUpdateAbilityStatus(AbilityTag, Status, AbilitySpec->Level);
-		MarkAbilitySpecDirty(*AbilitySpec);
+		FAuraScopedAbilityUpdate AbilityUpdate(*this);
+		QueueAbilityStatusUpdate(AbilityTag, Status, AbilitySpec->Level);
+		QueueSpecDirty(*AbilitySpec);
 	}
 }
 
@@ -332,21 +609,31 @@ void UAuraAbilitySystemComponent::ServerUpgradeAttribute_Implementation(const FG
 
 void UAuraAbilitySystemComponent::ClearAbilitiesOfSlot(const FGameplayTag& Slot)
 {
-	FScopedAbilityListLock ActiveScopeLock(*this);
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	const FAuraInputSlot* InputSlot = GetInputSlot(Slot);
+	if (InputSlot == nullptr) return;
+
+	// ClearSlot removes the spec from the slot, go backward.
+	for (int32 i = InputSlot->Specs.Num() - 1; i >= 0; i--)
 	{
-		if (AbilityHasSlot(&AbilitySpec, Slot))
-		{
-			ClearSlot(&AbilitySpec);
-		}
+		ClearSlot(&ActivatableAbilities.Items[InputSlot->Specs[i].Index]);
 	}
 }
 
 void UAuraAbilitySystemComponent::ClearSlot(FGameplayAbilitySpec* Spec)
 {
-	const FGameplayTag& Slot = GetInputTagFromSpec(*Spec);
+	const FGameplayTag Slot = GetSpecTags(*Spec).InputTag;
 	Spec->DynamicAbilityTags.RemoveTag(Slot);
+	InvalidateSpecTags(*Spec);
 	//MarkAbilitySpecDirty(*Spec);
+
+	const int32 SlotIndex = GetInputSlotIndex(Slot);
+	if (SlotIndex != INDEX_NONE)
+	{
+		InputSlots[SlotIndex].Specs.RemoveAll([Spec](const FAuraAbilitySpecIndex& SpecIndex)
+		{
+			return SpecIndex.Handle == Spec->Handle;
+		});
+	}
 }
 
 bool UAuraAbilitySystemComponent::AbilityHasSlot(FGameplayAbilitySpec* Spec, const FGameplayTag& Slot)
@@ -366,9 +653,11 @@ void UAuraAbilitySystemComponent::ServerEquipAbility_Implementation(const FGamep
 {
 	if (FGameplayAbilitySpec* AbilitySpec = GetSpecFromAbilityTag(AbilityTag))
 	{
+		FAuraScopedAbilityUpdate AbilityUpdate(*this);
 		const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
-		const FGameplayTag& PrevSlot = GetInputTagFromSpec(*AbilitySpec);
-		const FGameplayTag& Status = GetStatusFromSpec(*AbilitySpec);
+		const FAuraAbilitySpecTags SpecTags = GetSpecTags(*AbilitySpec);
+		const FGameplayTag PrevSlot = SpecTags.InputTag;
+		const FGameplayTag Status = SpecTags.StatusTag;
 		const bool bStatusValid = Status == GameplayTags.Abilities_Status_Equipped || Status == GameplayTags.Abilities_Status_Unlocked;
 		if (bStatusValid)
 		{
@@ -380,26 +669,28 @@ void UAuraAbilitySystemComponent::ServerEquipAbility_Implementation(const FGamep
 			// }
 			if (FGameplayAbilitySpec* SlotSpec = GetSpecWithSlot(SelectedSlot)) // There is an ability in this slot already. Deactivate and clear its slot.
 			{
-				const FGameplayTag AbilityTagSelectedSlot = GetAbilityTagFromSpec(*SlotSpec);
+				const FAuraAbilitySpecTags SlotSpecTags = GetSpecTags(*SlotSpec);
+				const FGameplayTag AbilityTagSelectedSlot = SlotSpecTags.AbilityTag;
 				// Is that ability the same as this ability ? If so, we can return early.
 				if (AbilityTag.MatchesTagExact(AbilityTagSelectedSlot))
 				{
-					ClientEquipAbility(AbilityTag, GameplayTags.Abilities_Status_Equipped, SelectedSlot, PrevSlot);
+					QueueAbilityEquipUpdate(AbilityTag, GameplayTags.Abilities_Status_Equipped, SelectedSlot, PrevSlot);
 					return;
 				}
 
-				if (IsPassiveAbility(*SlotSpec))
+				if (SlotSpecTags.bIsPassive)
 				{
-					MultiCastActivatePassiveEffect(GetAbilityTagFromSpec(*SlotSpec), false);
+					MultiCastActivatePassiveEffect(AbilityTagSelectedSlot, false);
 					DeactivatePassiveAbilityDelegate.Broadcast(AbilityTagSelectedSlot);
 				}
 				
 				ClearSlot(SlotSpec);
+				QueueSpecDirty(*SlotSpec);
 			}
 
-			if (!AbilityHasAnySlot(*AbilitySpec)) // Ability doesn't yet have a slot (it's not active).
+			if (!PrevSlot.IsValid()) // Ability doesn't yet have a slot (it's not active).
 			{
-				if (IsPassiveAbility(*AbilitySpec))
+				if (SpecTags.bIsPassive)
 				{
 					TryActivateAbility(AbilitySpec->Handle);
 					MultiCastActivatePassiveEffect(AbilityTag, true);
@@ -407,16 +698,71 @@ void UAuraAbilitySystemComponent::ServerEquipAbility_Implementation(const FGamep
 			}
 			AssignSlotToAbility(*AbilitySpec,SelectedSlot);
 			
-			MarkAbilitySpecDirty(*AbilitySpec);
-			ClientEquipAbility(AbilityTag, GameplayTags.Abilities_Status_Equipped, SelectedSlot, PrevSlot);
+			QueueSpecDirty(*AbilitySpec);
+			QueueAbilityEquipUpdate(AbilityTag, GameplayTags.Abilities_Status_Equipped, SelectedSlot, PrevSlot);
 		}
 	}
 }
 
-void UAuraAbilitySystemComponent::ClientEquipAbility_Implementation(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag,
+void UAuraAbilitySystemComponent::QueueAbilityStatusUpdate(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag, int32 AbilityLevel)
+{
+	FAuraAbilityUpdate& Update = PendingAbilityUpdates.AddDefaulted_GetRef();
+	Update.AbilityTag = AbilityTag;
+	Update.StatusTag = StatusTag;
+	Update.AbilityLevel = AbilityLevel;
+	if (AbilityUpdateBatchDepth == 0)
+	{
+		FlushAbilityUpdates();
+	}
+}
+
+void UAuraAbilitySystemComponent::QueueAbilityEquipUpdate(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag,
 	const FGameplayTag& SelectedSlot, const FGameplayTag& PreviousSlot)
 {
-	AbilityEquippedDelegate.Broadcast(AbilityTag, StatusTag, SelectedSlot, PreviousSlot);
+	FAuraAbilityUpdate& Update = PendingAbilityUpdates.AddDefaulted_GetRef();
+	Update.AbilityTag = AbilityTag;
+	Update.StatusTag = StatusTag;
+	Update.bIsEquip = true;
+	Update.SelectedSlot = SelectedSlot;
+	Update.PreviousSlot = PreviousSlot;
+	if (AbilityUpdateBatchDepth == 0)
+	{
+		FlushAbilityUpdates();
+	}
+}
+
+void UAuraAbilitySystemComponent::QueueSpecDirty(FGameplayAbilitySpec& Spec)
+{
+	InvalidateSpecTags(Spec);
+	PendingDirtySpecs.AddUnique(Spec.Handle);
+	if (AbilityUpdateBatchDepth == 0)
+	{
+		FlushAbilityUpdates();
+	}
+}
+
+void UAuraAbilitySystemComponent::FlushAbilityUpdates()
+{
+	// Specs changed several times by the batch are only marked once.
+	for (const FGameplayAbilitySpecHandle& Handle : PendingDirtySpecs)
+	{
+		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(Handle))
+		{
+			MarkAbilitySpecDirty(*AbilitySpec);
+		}
+	}
+	if (PendingDirtySpecs.Num() > 0)
+	{
+		// The owner may be replicating at its idle rate.
+		ForceReplication();
+	}
+	PendingDirtySpecs.Reset();
+
+	if (PendingAbilityUpdates.Num() > 0)
+	{
+		ClientApplyAbilityUpdates(PendingAbilityUpdates);
+		PendingAbilityUpdates.Reset();
+	}
 }
 
 bool UAuraAbilitySystemComponent::GetDescriptionsByAbilityTag(const FGameplayTag& AbilityTag, FString& OutDescription,
@@ -456,23 +802,21 @@ void UAuraAbilitySystemComponent::ServerHandleTalent_Implementation(const FGamep
 			if (AbilitySpec->DynamicAbilityTags.HasTagExact(TalentTag))
 			{
 				// We update the level of the gameplay Effect.
-				FGameplayEffectQuery GameplayEffectQuery = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(TalentTag.GetSingleTagContainer());
-				TArray<FActiveGameplayEffectHandle> TalentEffectFound = ActiveGameplayEffects.GetActiveEffects(GameplayEffectQuery);
-				if (TalentEffectFound.IsEmpty())
+				const FActiveGameplayEffectHandle Handle = FindTalentEffectHandle(TalentTag);
+				if (!Handle.IsValid())
 				{
 					// Create effect ?
 				}
 				else
 				{
-					FActiveGameplayEffectHandle Handle = TalentEffectFound[0];
 					if (DeactivateTalent)
 					{
+						// OnTalentEffectRemoved drops the handle.
 						RemoveActiveGameplayEffect(Handle, 1);
 					}
-					else
+					else if (const FActiveGameplayEffect* ActiveGameplayEffect = GetActiveGameplayEffect(Handle))
 					{
-						FActiveGameplayEffect* ActiveGameplayEffect = ActiveGameplayEffects.GetActiveGameplayEffect(Handle);
-						ActiveGameplayEffects.SetActiveGameplayEffectLevel(Handle, ActiveGameplayEffect->Spec.GetLevel() + 1);
+						SetActiveGameplayEffectLevel(Handle, ActiveGameplayEffect->Spec.GetLevel() + 1);
 					}
 				}
 			}
@@ -480,19 +824,55 @@ void UAuraAbilitySystemComponent::ServerHandleTalent_Implementation(const FGamep
 			{
 				// We add the gameplay Effect.
 				AbilitySpec->DynamicAbilityTags.AddTag(TalentTag);
-				MarkAbilitySpecDirty(*AbilitySpec);
+				MarkSpecDirty(*AbilitySpec);
 				
 				FGameplayEffectContextHandle EffectContextHandle = MakeEffectContext();
 				EffectContextHandle.AddSourceObject(GetAvatarActor());
 				
 				const FGameplayEffectSpecHandle EffectSpecHandle = MakeOutgoingSpec(TalentGameplayEffect, 1, EffectContextHandle);
 				EffectSpecHandle.Data->AddDynamicAssetTag(TalentTag);
-				FActiveGameplayEffectHandle ActiveGameplayEffectHandle = ApplyGameplayEffectSpecToTarget(*EffectSpecHandle.Data.Get(), this);
+				const FActiveGameplayEffectHandle ActiveGameplayEffectHandle = ApplyGameplayEffectSpecToTarget(*EffectSpecHandle.Data.Get(), this);
+				if (ActiveGameplayEffectHandle.IsValid())
+				{
+					AddTalentEffectHandle(TalentTag, ActiveGameplayEffectHandle);
+				}
 			}
 		}
 	}
 }
 
+FActiveGameplayEffectHandle UAuraAbilitySystemComponent::FindTalentEffectHandle(const FGameplayTag& TalentTag)
+{
+	if (const FActiveGameplayEffectHandle* Handle = TalentEffectHandles.Find(TalentTag))
+	{
+		return *Handle;
+	}
+
+	// Talent effects not applied by ServerHandleTalent (loaded, granted by another effect...) are only found by a query.
+	const FGameplayEffectQuery GameplayEffectQuery = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(TalentTag.GetSingleTagContainer());
+	const TArray<FActiveGameplayEffectHandle> TalentEffectFound = ActiveGameplayEffects.GetActiveEffects(GameplayEffectQuery);
+	if (TalentEffectFound.IsEmpty()) return FActiveGameplayEffectHandle();
+
+	AddTalentEffectHandle(TalentTag, TalentEffectFound[0]);
+	return TalentEffectFound[0];
+}
+
+void UAuraAbilitySystemComponent::AddTalentEffectHandle(const FGameplayTag& TalentTag, const FActiveGameplayEffectHandle& Handle)
+{
+	TalentEffectHandles.Add(TalentTag, Handle);
+	TalentTagsByEffect.Add(Handle, TalentTag);
+}
+
+void UAuraAbilitySystemComponent::OnTalentEffectRemoved(const FActiveGameplayEffect& RemovedEffect)
+{
+	// Also covers talent effects removed by something else than ServerHandleTalent (respec, expiration...).
+	FGameplayTag TalentTag;
+	if (TalentTagsByEffect.RemoveAndCopyValue(RemovedEffect.Handle, TalentTag))
+	{
+		TalentEffectHandles.Remove(TalentTag);
+	}
+}
+
 // void UAuraAbilitySystemComponent::ServerSpendSkillPoint_Implementation(const FGameplayTag& AbilityTag, const FGameplayTag& TalentTag, const int32 SkillPoint)
 // {
 // 	if (FGameplayAbilitySpec* AbilitySpec = GetSpecFromAbilityTag(AbilityTag))
@@ -523,9 +903,32 @@ void UAuraAbilitySystemComponent::ServerHandleTalent_Implementation(const FGamep
 
 /////// End of SKILLS ////////
 
+void UAuraAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
+{
+	Super::NotifyAbilityActivated(Handle, Ability);
+	if (!FAuraAbilityLatencyTracker::IsEnabled()) return;
+
+	const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(Handle);
+	if (AbilitySpec && Ability)
+	{
+		FAuraAbilityLatencyTracker::MarkActivated(this, GetSpecTags(*AbilitySpec).AbilityTag, Ability->GetCurrentActivationInfo().GetActivationPredictionKey());
+	}
+}
+
+bool UAuraAbilitySystemComponent::CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack)
+{
+	// Once per call, a multicast is then sent to every relevant connection.
+	FAuraNetProfiler::RecordRpc(GetOwner(), Function, Parameters);
+	return Super::CallRemoteFunction(Function, Parameters, OutParms, Stack);
+}
+
 void UAuraAbilitySystemComponent::OnRep_ActivateAbilities()
 {
 	Super::OnRep_ActivateAbilities();
+	// Input tags are part of the replicated DynamicAbilityTags.
+	bAbilityTagMapDirty = true;
+	bInputSlotsDirty = true;
+	SpecTagsCache.Reset();
 	if (!bStartupAbilitiesGiven)
 	{
 		// Replicate for client.
@@ -534,17 +937,63 @@ void UAuraAbilitySystemComponent::OnRep_ActivateAbilities()
 	}
 }
 
-void UAuraAbilitySystemComponent::ClientEffectApplied_Implementation(UAbilitySystemComponent* AbilitySystemComponent,
-                                                                     const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle)
+void UAuraAbilitySystemComponent::OnEffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent,
+                                                        const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle)
 {
 	FGameplayTagContainer TagContainer;
 	EffectSpec.GetAllAssetTags(TagContainer);
+	// Nothing to show for effects without asset tags, like most damage and debuff ticks.
+	if (TagContainer.IsEmpty()) return;
+
+	if (PendingEffectAssetTags.EffectTagCounts.IsEmpty())
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UAuraAbilitySystemComponent::FlushAppliedEffectTags);
+	}
+	const int32 NumTags = FMath::Min(TagContainer.Num(), static_cast<int32>(MAX_uint8));
+	for (int32 TagIndex = 0; TagIndex < NumTags; TagIndex++)
+	{
+		PendingEffectAssetTags.Tags.Add(TagContainer.GetByIndex(TagIndex));
+	}
+	PendingEffectAssetTags.EffectTagCounts.Add(static_cast<uint8>(NumTags));
+}
+
+void UAuraAbilitySystemComponent::FlushAppliedEffectTags()
+{
+	if (PendingEffectAssetTags.EffectTagCounts.IsEmpty()) return;
+
+	ClientEffectsApplied(PendingEffectAssetTags);
+	PendingEffectAssetTags.Tags.Reset();
+	PendingEffectAssetTags.EffectTagCounts.Reset();
+}
 
-	EffectAssetTags.Broadcast(TagContainer);
+void UAuraAbilitySystemComponent::ClientEffectsApplied_Implementation(const FAuraEffectAssetTagsBatch& Batch)
+{
+	// One broadcast per applied effect, as if each had its own RPC.
+	FGameplayTagContainer TagContainer;
+	int32 TagIndex = 0;
+	for (const uint8 EffectTagCount : Batch.EffectTagCounts)
+	{
+		TagContainer.Reset();
+		for (int32 i = 0; i < EffectTagCount && Batch.Tags.IsValidIndex(TagIndex); i++)
+		{
+			TagContainer.AddTagFast(Batch.Tags[TagIndex++]);
+		}
+		EffectAssetTags.Broadcast(TagContainer);
+	}
 }
 
-void UAuraAbilitySystemComponent::ClientUpdateAbilityStatus_Implementation(const FGameplayTag& AbilityTag,
-	const FGameplayTag& StatusTag, const int32 AbilityLevel)
+void UAuraAbilitySystemComponent::ClientApplyAbilityUpdates_Implementation(const TArray<FAuraAbilityUpdate>& Updates)
 {
-		AbilityStatusChangedDelegate.Broadcast(AbilityTag, StatusTag, AbilityLevel);
+	// In the order of the server operation, so the menus see the same sequence of changes.
+	for (const FAuraAbilityUpdate& Update : Updates)
+	{
+		if (Update.bIsEquip)
+		{
+			AbilityEquippedDelegate.Broadcast(Update.AbilityTag, Update.StatusTag, Update.SelectedSlot, Update.PreviousSlot);
+		}
+		else
+		{
+			AbilityStatusChangedDelegate.Broadcast(Update.AbilityTag, Update.StatusTag, Update.AbilityLevel);
+		}
+	}
 }
@@ -8,8 +8,10 @@
 #include "AbilitySystemComponent.h"
 #include "AuraAbilityTypes.h"
 #include "AuraGameplayTags.h"
+#include "AbilitySystem/AuraSpreadPatterns.h"
 #include "Game/AuraGameModeBase.h"
 #include "Interaction/CombatInterface.h"
+#include "Components/PrimitiveComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Player/AuraPlayerState.h"
 #include "UI/HUD/AuraHUD.h"
@@ -212,9 +214,9 @@ float UAuraAbilitySystemLibrary::GetDebuffFrequency(const FGameplayEffectContext
 FGameplayTag UAuraAbilitySystemLibrary::GetDamageType(const FGameplayEffectContextHandle& EffectContextHandle)
 {
 	const FAuraGameplayEffectContext* AuraContext = static_cast<const FAuraGameplayEffectContext*>(EffectContextHandle.Get());
-	if (AuraContext && AuraContext->GetDamageType().IsValid())
+	if (AuraContext)
 	{
-		return *AuraContext->GetDamageType();
+		return AuraContext->GetDamageType();
 	}
 	return FGameplayTag();
 }
@@ -282,9 +284,9 @@ FVector UAuraAbilitySystemLibrary::GetRadialDamageOrigin(const FGameplayEffectCo
 FGameplayTag UAuraAbilitySystemLibrary::GetSkillTag(const FGameplayEffectContextHandle& EffectContextHandle)
 {
 	const FAuraGameplayEffectContext* AuraContext = static_cast<const FAuraGameplayEffectContext*>(EffectContextHandle.Get());
-	if (AuraContext && AuraContext->GetSkillTag().IsValid())
+	if (AuraContext)
 	{
-		return *AuraContext->GetSkillTag();
+		return AuraContext->GetSkillTag();
 	}
 	return FGameplayTag();
 }
@@ -348,8 +350,7 @@ void UAuraAbilitySystemLibrary::SetDamageType(FGameplayEffectContextHandle& Effe
 	FAuraGameplayEffectContext* AuraContext = static_cast<FAuraGameplayEffectContext*>(EffectContextHandle.Get());
 	if (AuraContext && InDamageType.IsValid())
 	{
-		const TSharedPtr<FGameplayTag> DamageType = MakeShared<FGameplayTag>(InDamageType);
-		return AuraContext->SetDamageType(DamageType);
+		return AuraContext->SetDamageType(InDamageType);
 	}
 }
 
@@ -416,32 +417,233 @@ void UAuraAbilitySystemLibrary::SetSkillTag(FGameplayEffectContextHandle& Effect
 	FAuraGameplayEffectContext* AuraContext = static_cast<FAuraGameplayEffectContext*>(EffectContextHandle.Get());
 	if (AuraContext && InSkillTag.IsValid())
 	{
-		const TSharedPtr<FGameplayTag> SkillTag = MakeShared<FGameplayTag>(InSkillTag);
-		return AuraContext->SetSkillTag(SkillTag);
+		return AuraContext->SetSkillTag(InSkillTag);
 	}
 }
 
-void UAuraAbilitySystemLibrary::GetLivePlayersWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
-                                                           const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& SphereOrigin)
+namespace
 {
-	FCollisionQueryParams SphereParams;
-	SphereParams.AddIgnoredActors(ActorsToIgnore);
+	// Overlapping components of live combat actors found by the broadphase, one candidate per component. Bounds are
+	// stored as structure of arrays so the narrow-phase tests below are plain float loops the compiler can vectorize.
+	struct FLiveTargetCandidates
+	{
+		TArray<AActor*, TInlineAllocator<32>> Actors;
+		TArray<float, TInlineAllocator<32>> X;
+		TArray<float, TInlineAllocator<32>> Y;
+		TArray<float, TInlineAllocator<32>> Z;
+		// Radius of the bounding sphere of the component, so large bodies crossing the edge of a shape count.
+		TArray<float, TInlineAllocator<32>> Radius;
+		// 1 if the candidate passed the narrow-phase test.
+		TArray<uint8, TInlineAllocator<32>> Mask;
+
+		int32 Num() const { return Actors.Num(); }
+	};
 
-	if (const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	// Shared broadphase for every area query: one sphere overlap bounding the shape, keeping only live combat actors.
+	// Positions are stored relative to Origin to keep float precision on large maps.
+	void GatherLiveTargetCandidates(const UObject* WorldContextObject, const TArray<AActor*>& ActorsToIgnore, const FVector& Origin, float BoundingRadius, FLiveTargetCandidates& OutCandidates)
 	{
+		FCollisionQueryParams SphereParams;
+		SphereParams.AddIgnoredActors(ActorsToIgnore);
+
+		const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+		if (World == nullptr) return;
+
 		TArray<FOverlapResult> Overlaps;
-		// TODO Changer la CollisionSHape pour passer en parametre. CollisionShape - supports Box, Sphere, Capsule
-		World->OverlapMultiByObjectType(Overlaps, SphereOrigin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeSphere(Radius), SphereParams);
+		World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeSphere(BoundingRadius), SphereParams);
 		for (FOverlapResult& Overlap : Overlaps)
 		{
-			if (Overlap.GetActor()->Implements<UCombatInterface>() && !ICombatInterface::Execute_IsDead(Overlap.GetActor()))
+			AActor* OverlapActor = Overlap.GetActor();
+			if (OverlapActor == nullptr || !OverlapActor->Implements<UCombatInterface>() || ICombatInterface::Execute_IsDead(OverlapActor)) continue;
+
+			// The same actor is returned once per overlapping component, each one is tested and the actor is only
+			// committed once.
+			AActor* Avatar = ICombatInterface::Execute_GetAvatar(OverlapActor);
+			const UPrimitiveComponent* Component = Overlap.GetComponent();
+			if (Avatar == nullptr || Component == nullptr) continue;
+
+			const FVector Location = Component->Bounds.Origin - Origin;
+			OutCandidates.Actors.Add(Avatar);
+			OutCandidates.X.Add(Location.X);
+			OutCandidates.Y.Add(Location.Y);
+			OutCandidates.Z.Add(Location.Z);
+			OutCandidates.Radius.Add(Component->Bounds.SphereRadius);
+		}
+		OutCandidates.Mask.SetNumZeroed(OutCandidates.Num());
+	}
+
+	void CommitLiveTargetCandidates(const FLiveTargetCandidates& Candidates, TArray<AActor*>& OutOverlappingActors)
+	{
+		for (int32 i = 0; i < Candidates.Num(); i++)
+		{
+			if (Candidates.Mask[i])
 			{
-				OutOverlappingActors.AddUnique(ICombatInterface::Execute_GetAvatar(Overlap.GetActor()));
+				OutOverlappingActors.AddUnique(Candidates.Actors[i]);
 			}
 		}
 	}
 }
 
+void UAuraAbilitySystemLibrary::GetLivePlayersWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
+                                                           const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& SphereOrigin)
+{
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, SphereOrigin, Radius, Candidates);
+
+	// The sphere overlap is already exact (any overlapping component counts), no narrow-phase needed.
+	FMemory::Memset(Candidates.Mask.GetData(), 1, Candidates.Num());
+	CommitLiveTargetCandidates(Candidates, OutOverlappingActors);
+}
+
+void UAuraAbilitySystemLibrary::GetLivePlayersWithinBox(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
+	const TArray<AActor*>& ActorsToIgnore, const FVector& BoxCenter, const FRotator& BoxRotation, const FVector& HalfExtent)
+{
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, BoxCenter, HalfExtent.Size(), Candidates);
+
+	// Project every candidate on the box axes once, no per-candidate matrix.
+	const FRotationMatrix RotationMatrix(BoxRotation);
+	const FVector3f AxisX = FVector3f(RotationMatrix.GetUnitAxis(EAxis::X));
+	const FVector3f AxisY = FVector3f(RotationMatrix.GetUnitAxis(EAxis::Y));
+	const FVector3f AxisZ = FVector3f(RotationMatrix.GetUnitAxis(EAxis::Z));
+	const FVector3f Extent = FVector3f(HalfExtent.GetAbs());
+
+	const int32 Num = Candidates.Num();
+	const float* RESTRICT X = Candidates.X.GetData();
+	const float* RESTRICT Y = Candidates.Y.GetData();
+	const float* RESTRICT Z = Candidates.Z.GetData();
+	const float* RESTRICT R = Candidates.Radius.GetData();
+	uint8* RESTRICT Mask = Candidates.Mask.GetData();
+	for (int32 i = 0; i < Num; i++)
+	{
+		// Distance from the bounding sphere center to the box, per local axis.
+		const float DX = FMath::Max(FMath::Abs(X[i] * AxisX.X + Y[i] * AxisX.Y + Z[i] * AxisX.Z) - Extent.X, 0.f);
+		const float DY = FMath::Max(FMath::Abs(X[i] * AxisY.X + Y[i] * AxisY.Y + Z[i] * AxisY.Z) - Extent.Y, 0.f);
+		const float DZ = FMath::Max(FMath::Abs(X[i] * AxisZ.X + Y[i] * AxisZ.Y + Z[i] * AxisZ.Z) - Extent.Z, 0.f);
+		Mask[i] = (DX * DX + DY * DY + DZ * DZ) <= R[i] * R[i];
+	}
+	CommitLiveTargetCandidates(Candidates, OutOverlappingActors);
+}
+
+void UAuraAbilitySystemLibrary::GetLivePlayersWithinCapsule(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
+	const TArray<AActor*>& ActorsToIgnore, const FVector& CapsuleStart, const FVector& CapsuleEnd, float Radius)
+{
+	const FVector Center = (CapsuleStart + CapsuleEnd) * 0.5f;
+	const FVector3f HalfSegment = FVector3f(CapsuleEnd - Center);
+
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, Center, HalfSegment.Size() + Radius, Candidates);
+
+	// Candidates are relative to the capsule center, so the segment goes from -HalfSegment to +HalfSegment.
+	const float HalfLengthSquared = HalfSegment.SizeSquared();
+	const float InvHalfLengthSquared = HalfLengthSquared > UE_KINDA_SMALL_NUMBER ? 1.f / HalfLengthSquared : 0.f;
+
+	const int32 Num = Candidates.Num();
+	const float* RESTRICT X = Candidates.X.GetData();
+	const float* RESTRICT Y = Candidates.Y.GetData();
+	const float* RESTRICT Z = Candidates.Z.GetData();
+	const float* RESTRICT R = Candidates.Radius.GetData();
+	uint8* RESTRICT Mask = Candidates.Mask.GetData();
+	for (int32 i = 0; i < Num; i++)
+	{
+		const float T = FMath::Clamp((X[i] * HalfSegment.X + Y[i] * HalfSegment.Y + Z[i] * HalfSegment.Z) * InvHalfLengthSquared, -1.f, 1.f);
+		const float DX = X[i] - HalfSegment.X * T;
+		const float DY = Y[i] - HalfSegment.Y * T;
+		const float DZ = Z[i] - HalfSegment.Z * T;
+		const float ReachedRadius = Radius + R[i];
+		Mask[i] = (DX * DX + DY * DY + DZ * DZ) <= ReachedRadius * ReachedRadius;
+	}
+	CommitLiveTargetCandidates(Candidates, OutOverlappingActors);
+}
+
+void UAuraAbilitySystemLibrary::GetLivePlayersWithinCone(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
+	const TArray<AActor*>& ActorsToIgnore, const FVector& ConeOrigin, const FVector& Direction, float Length, float HalfAngle)
+{
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, ConeOrigin, Length, Candidates);
+
+	const FVector3f Dir = FVector3f(Direction.GetSafeNormal());
+	float SinHalfAngle, CosHalfAngle;
+	FMath::SinCos(&SinHalfAngle, &CosHalfAngle, FMath::DegreesToRadians(FMath::Clamp(HalfAngle, 0.f, 180.f)));
+
+	const int32 Num = Candidates.Num();
+	const float* RESTRICT X = Candidates.X.GetData();
+	const float* RESTRICT Y = Candidates.Y.GetData();
+	const float* RESTRICT Z = Candidates.Z.GetData();
+	const float* RESTRICT R = Candidates.Radius.GetData();
+	uint8* RESTRICT Mask = Candidates.Mask.GetData();
+	for (int32 i = 0; i < Num; i++)
+	{
+		const float DistanceSquared = X[i] * X[i] + Y[i] * Y[i] + Z[i] * Z[i];
+		const float Projection = X[i] * Dir.X + Y[i] * Dir.Y + Z[i] * Dir.Z;
+		const float Perpendicular = FMath::Sqrt(FMath::Max(DistanceSquared - Projection * Projection, 0.f));
+		// Distance from the bounding sphere center to the side of the cone (negative inside), without acos. Behind
+		// the apex the closest point of the cone is the apex itself.
+		const bool bBehindApex = Projection * CosHalfAngle + Perpendicular * SinHalfAngle < 0.f;
+		const float SideDistance = bBehindApex ? FMath::Sqrt(DistanceSquared) : Perpendicular * CosHalfAngle - Projection * SinHalfAngle;
+		const float ReachedLength = Length + R[i];
+		Mask[i] = (DistanceSquared <= ReachedLength * ReachedLength) & (SideDistance <= R[i]);
+	}
+	CommitLiveTargetCandidates(Candidates, OutOverlappingActors);
+}
+
+void UAuraAbilitySystemLibrary::GetLivePlayersWithinRing(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
+	const TArray<AActor*>& ActorsToIgnore, const FVector& RingOrigin, float InnerRadius, float OuterRadius)
+{
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, RingOrigin, OuterRadius, Candidates);
+
+	const int32 Num = Candidates.Num();
+	const float* RESTRICT X = Candidates.X.GetData();
+	const float* RESTRICT Y = Candidates.Y.GetData();
+	const float* RESTRICT R = Candidates.Radius.GetData();
+	uint8* RESTRICT Mask = Candidates.Mask.GetData();
+	for (int32 i = 0; i < Num; i++)
+	{
+		// Ground plane only, the height is bounded by the broadphase sphere.
+		const float Distance2D = FMath::Sqrt(X[i] * X[i] + Y[i] * Y[i]);
+		Mask[i] = (Distance2D + R[i] >= InnerRadius) & (Distance2D - R[i] <= OuterRadius);
+	}
+	CommitLiveTargetCandidates(Candidates, OutOverlappingActors);
+}
+
+void UAuraAbilitySystemLibrary::GetNearestLiveEnemies(const UObject* WorldContextObject, AActor* SourceActor, TArray<AActor*>& OutNearestActors,
+	const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& Origin, int32 MaxTargets)
+{
+	if (MaxTargets <= 0) return;
+
+	FLiveTargetCandidates Candidates;
+	GatherLiveTargetCandidates(WorldContextObject, ActorsToIgnore, Origin, Radius, Candidates);
+
+	TArray<float, TInlineAllocator<32>> DistancesSquared;
+	DistancesSquared.SetNumUninitialized(Candidates.Num());
+	for (int32 i = 0; i < Candidates.Num(); i++)
+	{
+		DistancesSquared[i] = Candidates.X[i] * Candidates.X[i] + Candidates.Y[i] * Candidates.Y[i] + Candidates.Z[i] * Candidates.Z[i];
+	}
+
+	TArray<int32, TInlineAllocator<32>> Order;
+	for (int32 i = 0; i < Candidates.Num(); i++)
+	{
+		if (SourceActor == nullptr || IsNotFriend(SourceActor, Candidates.Actors[i]))
+		{
+			Order.Add(i);
+		}
+	}
+	Order.Sort([&DistancesSquared](const int32 A, const int32 B) { return DistancesSquared[A] < DistancesSquared[B]; });
+
+	// Candidates are per component, an actor is ranked by its closest one.
+	int32 NumTargets = 0;
+	for (int32 i = 0; i < Order.Num() && NumTargets < MaxTargets; i++)
+	{
+		if (!OutNearestActors.Contains(Candidates.Actors[Order[i]]))
+		{
+			OutNearestActors.Add(Candidates.Actors[Order[i]]);
+			NumTargets++;
+		}
+	}
+}
+
 void UAuraAbilitySystemLibrary::GetClosestTargets(int32 MaxTargets, const TArray<AActor*>& Actors, TArray<AActor*>& OutClosestTargets, const FVector& Origin)
 {
 	if (Actors.Num() <= MaxTargets)
@@ -550,6 +752,19 @@ void UAuraAbilitySystemLibrary::SetKnockbackDirection(FDamageEffectParams& Damag
 	}
 }
 
+FDamageEffectTargetParams UAuraAbilitySystemLibrary::MakeDamageEffectTargetParams(const FDamageEffectParams& DamageEffectParams, UAbilitySystemComponent* InASC, FVector HitDirection)
+{
+	HitDirection.Normalize();
+	FDamageEffectTargetParams TargetParams;
+	TargetParams.TargetAbilitySystemComponent = InASC;
+	TargetParams.DeathImpulse = HitDirection * DamageEffectParams.DeathImpulseMagnitude;
+	if (FMath::RandRange(1, 100) < DamageEffectParams.KnockbackChance)
+	{
+		TargetParams.KnockbackForce = HitDirection * DamageEffectParams.KnockbackForceMagnitude;
+	}
+	return TargetParams;
+}
+
 void UAuraAbilitySystemLibrary::SetDeathImpulseDirection(FDamageEffectParams& DamageEffectParams, FVector ImpulseDirection, float Magnitude)
 {
 	ImpulseDirection.Normalize();
@@ -598,13 +813,22 @@ FGameplayEffectContextHandle UAuraAbilitySystemLibrary::ApplyDamageEffect(const
 }
 
 FGameplayEffectContextHandle UAuraAbilitySystemLibrary::ApplySkillDamageEffect(const FDamageEffectParams& Params)
+{
+	FDamageEffectTargetParams TargetParams;
+	TargetParams.TargetAbilitySystemComponent = Params.TargetAbilitySystemComponent;
+	TargetParams.DeathImpulse = Params.DeathImpulse;
+	TargetParams.KnockbackForce = Params.KnockbackForce;
+	return ApplySkillDamageEffectToTarget(Params, TargetParams);
+}
+
+FGameplayEffectContextHandle UAuraAbilitySystemLibrary::ApplySkillDamageEffectToTarget(const FDamageEffectParams& Params, const FDamageEffectTargetParams& TargetParams)
 {
 	const AActor* SourceAvatarActor = Params.SourceAbilitySystemComponent->GetAvatarActor();
 	
 	FGameplayEffectContextHandle EffectContextHandle = Params.SourceAbilitySystemComponent->MakeEffectContext();
 	EffectContextHandle.AddSourceObject(SourceAvatarActor);
-	SetDeathImpulse(EffectContextHandle, Params.DeathImpulse);
-	SetKnockbackForce(EffectContextHandle, Params.KnockbackForce);
+	SetDeathImpulse(EffectContextHandle, TargetParams.DeathImpulse);
+	SetKnockbackForce(EffectContextHandle, TargetParams.KnockbackForce);
 	
 	const FGameplayEffectSpecHandle SpecHandle = Params.SourceAbilitySystemComponent->MakeOutgoingSpec(Params.DamageGameplayEffectClass, Params.AbilityLevel, EffectContextHandle);
 
@@ -623,48 +847,27 @@ FGameplayEffectContextHandle UAuraAbilitySystemLibrary::ApplySkillDamageEffect(c
 	
 	// *SpecHandle.Data.Get() not necessary. Deferencing the wrapper will also give you the derefenced value inside of it.
 	// SpecHandle.Data will not be valid on client. So should be called when HasAuthority. See AuraProjectile::OnSphereOverlap
-	Params.TargetAbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
+	TargetParams.TargetAbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
 	return EffectContextHandle;
 }
 
 TArray<FRotator> UAuraAbilitySystemLibrary::EvenlySpaceRotators(const FVector& Forward, const FVector& Axis, float Spread, int32 NumRotators)
 {
+	FAuraSpreadDirections Directions;
+	FAuraSpreadPatterns::BuildDirections(EAuraSpreadPattern::Fan, Forward, Axis, Spread, FMath::Max(NumRotators, 1), Directions);
+
 	TArray<FRotator> Rotators;
-	const FVector LeftOfSpread = Forward.RotateAngleAxis(-Spread / 2.f, Axis);
-	if (NumRotators > 1)
-	{
-		// We must be sure to not divide by zero.
-		const float DeltaSpread = Spread / (NumRotators - 1);
-		for (int32 i = 0; i < NumRotators; i++)
-		{
-			const FVector Direction = LeftOfSpread.RotateAngleAxis(DeltaSpread * i, FVector::UpVector);
-			Rotators.Add(Direction.Rotation());
-		}
-	}
-	else
+	Rotators.Reserve(Directions.Num());
+	for (const FVector& Direction : Directions)
 	{
-		Rotators.Add(Forward.Rotation());
+		Rotators.Add(Direction.Rotation());
 	}
 	return Rotators;
 }
 
 TArray<FVector> UAuraAbilitySystemLibrary::EvenlyRotatedVectors(const FVector& Forward, const FVector& Axis, float Spread, int32 NumVectors)
 {
-	TArray<FVector> Vectors;
-	const FVector LeftOfSpread = Forward.RotateAngleAxis(-Spread / 2.f, Axis);
-	if (NumVectors > 1)
-	{
-		// We must be sure to not divide by zero.
-		const float DeltaSpread = Spread / (NumVectors - 1);
-		for (int32 i = 0; i < NumVectors; i++)
-		{
-			const FVector Direction = LeftOfSpread.RotateAngleAxis(DeltaSpread * i, FVector::UpVector);
-			Vectors.Add(Direction);
-		}
-	}
-	else
-	{
-		Vectors.Add(Forward);
-	}
-	return Vectors;
+	FAuraSpreadDirections Directions;
+	FAuraSpreadPatterns::BuildDirections(EAuraSpreadPattern::Fan, Forward, Axis, Spread, FMath::Max(NumVectors, 1), Directions);
+	return TArray<FVector>(Directions);
 }
@@ -0,0 +1,164 @@
+// Copyright Nono Studios
+
+
+#include "AbilitySystem/AuraSpreadPatterns.h"
+
+static TAutoConsoleVariable<int32> CVarSpreadPatternsMaxCached(
+	TEXT("Aura.SpreadPatterns.MaxCached"),
+	256,
+	TEXT("Maximum number of spread patterns kept in cache. The cache is emptied when a new pattern would exceed it."));
+
+namespace
+{
+	// Random cones draw their directions from a fixed table, the seed only picks which entries.
+	constexpr int32 RandomConeTableSize = 64;
+	constexpr int32 RandomConeTableSeed = 1337;
+
+	uint64 MakePatternKey(EAuraSpreadPattern Pattern, float Spread, int32 Count)
+	{
+		const uint32 QuantizedSpread = static_cast<uint32>(FMath::RoundToInt(Spread * 100.f));
+		return static_cast<uint64>(Pattern) << 56 | static_cast<uint64>(Count & 0xFFFFFF) << 32 | QuantizedSpread;
+	}
+
+	FVector3f MakeConeDirection(float Theta, float Phi)
+	{
+		float SinTheta, CosTheta, SinPhi, CosPhi;
+		FMath::SinCos(&SinTheta, &CosTheta, Theta);
+		FMath::SinCos(&SinPhi, &CosPhi, Phi);
+		return FVector3f(CosTheta, SinTheta * CosPhi, SinTheta * SinPhi);
+	}
+}
+
+TMap<uint64, TArray<FVector3f>> FAuraSpreadPatterns::PatternCache;
+
+void FAuraSpreadPatterns::BuildDirections(EAuraSpreadPattern Pattern, const FVector& Forward, const FVector& Axis, float Spread, int32 Count, FAuraSpreadDirections& OutDirections, int32 Seed)
+{
+	check(IsInGameThread());
+	OutDirections.Reset();
+	if (Count <= 0) return;
+
+	const FVector UnitAxis = Axis.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+	const bool bRotatesAroundAxis = Pattern == EAuraSpreadPattern::Fan || Pattern == EAuraSpreadPattern::Ring;
+
+	// Fans and rings are rotations of Forward around the axis, stored as (cos, sin, 1 - cos) for Rodrigues' formula.
+	// Cones are stored in a frame where X is Forward, Y its right and Z its up relative to the axis.
+	FVector BasisX, BasisY, BasisZ;
+	if (bRotatesAroundAxis)
+	{
+		BasisX = Forward;
+		BasisY = UnitAxis ^ Forward;
+		BasisZ = UnitAxis * (UnitAxis | Forward);
+	}
+	else
+	{
+		BasisX = Forward.GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+		BasisY = (UnitAxis ^ BasisX).GetSafeNormal();
+		if (BasisY.IsZero())
+		{
+			BasisX.FindBestAxisVectors(BasisY, BasisZ);
+		}
+		BasisZ = BasisX ^ BasisY;
+	}
+
+	const TArray<FVector3f>& LocalPattern = GetLocalPattern(Pattern, Spread, Count);
+	OutDirections.SetNumUninitialized(Count);
+	if (Pattern == EAuraSpreadPattern::RandomCone)
+	{
+		// An odd stride is coprime with the table size, so up to RandomConeTableSize directions never repeat.
+		const uint32 UnsignedSeed = static_cast<uint32>(Seed);
+		const uint32 Offset = UnsignedSeed % RandomConeTableSize;
+		const uint32 Stride = 1 + 2 * ((UnsignedSeed / RandomConeTableSize) % (RandomConeTableSize / 2));
+		for (int32 i = 0; i < Count; i++)
+		{
+			const FVector3f& Local = LocalPattern[(Offset + i * Stride) % RandomConeTableSize];
+			OutDirections[i] = BasisX * Local.X + BasisY * Local.Y + BasisZ * Local.Z;
+		}
+		return;
+	}
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		const FVector3f& Local = LocalPattern[i];
+		OutDirections[i] = BasisX * Local.X + BasisY * Local.Y + BasisZ * Local.Z;
+	}
+}
+
+void FAuraSpreadPatterns::ClearCache()
+{
+	PatternCache.Empty();
+}
+
+const TArray<FVector3f>& FAuraSpreadPatterns::GetLocalPattern(EAuraSpreadPattern Pattern, float Spread, int32 Count)
+{
+	// The random cone table does not depend on the count.
+	const int32 KeyCount = Pattern == EAuraSpreadPattern::RandomCone ? 0 : Count;
+	const float KeySpread = Pattern == EAuraSpreadPattern::Ring ? 0.f : Spread;
+	const uint64 Key = MakePatternKey(Pattern, KeySpread, KeyCount);
+	if (const TArray<FVector3f>* CachedPattern = PatternCache.Find(Key))
+	{
+		return *CachedPattern;
+	}
+
+	// Spreads and counts come from skill levels and upgrades, don't let every value ever cast stay in memory.
+	if (PatternCache.Num() >= CVarSpreadPatternsMaxCached.GetValueOnGameThread())
+	{
+		ClearCache();
+	}
+	TArray<FVector3f>& NewPattern = PatternCache.Add(Key);
+	ComputeLocalPattern(Pattern, KeySpread, KeyCount, NewPattern);
+	return NewPattern;
+}
+
+void FAuraSpreadPatterns::ComputeLocalPattern(EAuraSpreadPattern Pattern, float Spread, int32 Count, TArray<FVector3f>& OutPattern)
+{
+	const float HalfSpreadRadians = FMath::DegreesToRadians(Spread * 0.5f);
+	switch (Pattern)
+	{
+	case EAuraSpreadPattern::Fan:
+	case EAuraSpreadPattern::Ring:
+	{
+		OutPattern.Reserve(Count);
+		for (int32 i = 0; i < Count; i++)
+		{
+			float Angle = 0.f;
+			if (Pattern == EAuraSpreadPattern::Ring)
+			{
+				Angle = 2.f * UE_PI * i / Count;
+			}
+			else if (Count > 1)
+			{
+				Angle = -HalfSpreadRadians + 2.f * HalfSpreadRadians * i / (Count - 1);
+			}
+			float Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, Angle);
+			OutPattern.Add(FVector3f(Cos, Sin, 1.f - Cos));
+		}
+		break;
+	}
+	case EAuraSpreadPattern::Spiral:
+	{
+		// Vogel spiral: equal area rings, consecutive directions a golden angle apart.
+		const float GoldenAngle = UE_PI * (3.f - FMath::Sqrt(5.f));
+		OutPattern.Reserve(Count);
+		for (int32 i = 0; i < Count; i++)
+		{
+			const float Theta = Count > 1 ? HalfSpreadRadians * FMath::Sqrt(static_cast<float>(i) / (Count - 1)) : 0.f;
+			OutPattern.Add(MakeConeDirection(Theta, GoldenAngle * i));
+		}
+		break;
+	}
+	case EAuraSpreadPattern::RandomCone:
+	{
+		// Uniform over the cone solid angle.
+		FRandomStream RandomStream(RandomConeTableSeed);
+		const float CosHalfSpread = FMath::Cos(HalfSpreadRadians);
+		OutPattern.Reserve(RandomConeTableSize);
+		for (int32 i = 0; i < RandomConeTableSize; i++)
+		{
+			const float CosTheta = FMath::Lerp(1.f, CosHalfSpread, RandomStream.GetFraction());
+			OutPattern.Add(MakeConeDirection(FMath::Acos(CosTheta), 2.f * UE_PI * RandomStream.GetFraction()));
+		}
+		break;
+	}
+	}
+}
@@ -4,9 +4,12 @@
 #include "AbilitySystem/Skills/FireboltSkill.h"
 
 #include "AuraGameplayTags.h"
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
-#include "Actor/AuraProjectile.h"
-#include "GameFramework/ProjectileMovementComponent.h"
+#include "Actor/AuraPooledProjectile.h"
+#include "Actor/AuraProjectileSpawnSubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "Profiling/AuraAbilityLatencyTracker.h"
 
 FString UFireboltSkill::GetDescription(int32 Level)
 {
@@ -98,45 +101,77 @@ void UFireboltSkill::SpawnProjectiles(const FVector& ProjectileTargetLocation, c
 	}
 
 	// Its important to use MakeDamageEffectParamsFromClassDefaults before we try to use GetTalentsModifiersForAttribute
-	// because we setup the talent tree in it.
-	FDamageEffectParams EffectParams = MakeDamageEffectParamsFromClassDefaults();
+	// because we setup the talent tree in it. Each volley is a cast, held and auto-cast activations fire several.
+	ResetCastDamageEffectParams();
+	GetCastDamageEffectParams();
 	
 	int32 Projectiles = GetTalentsModifiersForAttribute(1, FAuraGameplayTags::Get().Skills_Attributes_MaxProjectiles);
 	NumberProjectiles = FMath::Min(MaxNumProjectiles, Projectiles);
 	
-	const FVector Forward = Rotation.Vector();
-	TArray<FRotator> Rotations = UAuraAbilitySystemLibrary::EvenlySpaceRotators(Forward, FVector::UpVector, ProjectileSpread, NumberProjectiles);
+	FAuraProjectileVolley Volley;
+	Volley.ProjectileClass = ProjectileClass;
+	Volley.Origin = SocketLocation;
+	Volley.Forward = Rotation.Vector();
+	Volley.Spread = ProjectileSpread;
+	Volley.NumProjectiles = FMath::Clamp(NumberProjectiles, 0, MAX_uint8);
+	Volley.AimDistance = FVector::Dist(SocketLocation, ProjectileTargetLocation);
+	Volley.bIsHoming = bLauncHomingProjectiles;
+	Volley.HomingAccelerationMin = HomingAccelerationMin;
+	Volley.HomingAccelerationMax = HomingAccelerationMax;
+	Volley.Seed = FMath::Rand();
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		Volley.ServerTime = GameState->GetServerWorldTimeSeconds();
+	}
 
-	for (const FRotator& Rot : Rotations)
+	// One query for the whole volley instead of every bolt chasing the same victim.
+	if (bLauncHomingProjectiles)
 	{
-		FTransform SpawnTransform;
-		SpawnTransform.SetLocation(SocketLocation);
-		SpawnTransform.SetRotation(Rot.Quaternion());
-
-		AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
-			ProjectileClass,
-			SpawnTransform,
-			GetOwningActorFromActorInfo(),
-			Cast<APawn>(GetOwningActorFromActorInfo()),
-			ESpawnActorCollisionHandlingMethod::AlwaysSpawn
-		);
-
-		Projectile->DamageEffectParams = EffectParams;
-
-		if (HomingTarget && HomingTarget->Implements<UCombatInterface>())
-		{
-			Projectile->ProjectileMovement->HomingTargetComponent = HomingTarget->GetRootComponent();
-		}
-		else
-		{
-			Projectile->HomingTargetSceneComponent = NewObject<USceneComponent>(USceneComponent::StaticClass());
-			Projectile->HomingTargetSceneComponent->SetWorldLocation(ProjectileTargetLocation);
-			Projectile->ProjectileMovement->HomingTargetComponent = Projectile->HomingTargetSceneComponent;
-		}
-		Projectile->ProjectileMovement->HomingAccelerationMagnitude = FMath::FRandRange(HomingAccelerationMin, HomingAccelerationMax);
-		Projectile->ProjectileMovement->bIsHomingProjectile = bLauncHomingProjectiles;
-		
-		Projectile->FinishSpawning(SpawnTransform);
+		TArray<AActor*> BoltTargets;
+		DistributeHomingTargets(ProjectileTargetLocation, HomingTarget, BoltTargets);
+		Volley.Targets.Append(BoltTargets);
+	}
 
+	// With volley replication the server bolts stay on the server, clients rebuild their own from the volley.
+	// Only pooled projectiles send their impacts, the client bolts of other classes would never stop.
+	UAuraAbilitySystemComponent* AuraASC = Cast<UAuraAbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
+	const bool bReplicateVolley = bUseVolleyReplication && AuraASC && ProjectileClass && ProjectileClass->IsChildOf<AAuraPooledProjectile>();
+	if (bReplicateVolley)
+	{
+		Volley.VolleyId = AuraASC->MakeProjectileVolleyId();
+	}
+	FAuraProjectileSpawnRequest Template = MakeProjectileSpawnRequest(FTransform::Identity);
+	Template.bReplicates = !bReplicateVolley;
+	Template.VolleyId = Volley.VolleyId;
+	GetWorld()->GetSubsystem<UAuraProjectileSpawnSubsystem>()->SpawnVolley(Volley, Template);
+	if (const FGameplayAbilitySpec* AbilitySpec = FAuraAbilityLatencyTracker::IsEnabled() ? GetCurrentAbilitySpec() : nullptr)
+	{
+		FAuraAbilityLatencyTracker::MarkFirstEffect(GetAbilitySystemComponentFromActorInfo(), UAuraAbilitySystemComponent::GetAbilityTagFromSpec(*AbilitySpec));
+	}
+
+	if (bReplicateVolley)
+	{
+		AuraASC->MulticastProjectileVolley(Volley);
 	}
 }
+
+void UFireboltSkill::DistributeHomingTargets(const FVector& AimLocation, AActor* HomingTarget, TArray<AActor*>& OutBoltTargets) const
+{
+	AActor* AvatarActor = GetAvatarActorFromActorInfo();
+	TArray<AActor*> ActorsToIgnore;
+	ActorsToIgnore.Add(AvatarActor);
+
+	// The clicked enemy always gets the first bolt.
+	FVector SearchOrigin = AimLocation;
+	if (HomingTarget && HomingTarget->Implements<UCombatInterface>())
+	{
+		OutBoltTargets.Add(HomingTarget);
+		ActorsToIgnore.Add(HomingTarget);
+		SearchOrigin = HomingTarget->GetActorLocation();
+	}
+
+	const int32 NumTargetsToFind = NumberProjectiles - OutBoltTargets.Num();
+	if (NumTargetsToFind <= 0) return;
+
+	UAuraAbilitySystemLibrary::GetNearestLiveEnemies(AvatarActor, AvatarActor, OutBoltTargets, ActorsToIgnore, HomingTargetSearchRadius, SearchOrigin, NumTargetsToFind);
+}
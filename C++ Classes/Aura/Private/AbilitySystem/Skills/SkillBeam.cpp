@@ -3,9 +3,11 @@
 
 #include "AbilitySystem/Skills/SkillBeam.h"
 
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "AbilitySystem/Skills/SkillBeamTraceSubsystem.h"
 #include "GameFramework/Character.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "Profiling/AuraAbilityLatencyTracker.h"
 
 FString USkillBeam::GetDescription(int32 Level)
 {
@@ -50,34 +52,57 @@ void USkillBeam::StoreMouseDataInfo(const FHitResult& HitResult)
 void USkillBeam::TraceFirstTarget(const FVector& BeamTargetLocation)
 {
 	check(OwnerCharacter);
-	if (OwnerCharacter->Implements<UCombatInterface>())
+	USkillBeamTraceSubsystem* BeamTraceSubsystem = GetWorld()->GetSubsystem<USkillBeamTraceSubsystem>();
+	if (BeamTraceSubsystem == nullptr) return;
+
+	if (BeamTraceSlot == INDEX_NONE)
+	{
+		if (!OwnerCharacter->Implements<UCombatInterface>()) return;
+		USkeletalMeshComponent* Weapon = ICombatInterface::Execute_GetWeapon(OwnerCharacter);
+		if (Weapon == nullptr) return;
+
+		BeamTraceSlot = BeamTraceSubsystem->RegisterBeam(this, Weapon, BeamSocketName, BeamTraceRadius, OwnerCharacter);
+		if (const FGameplayAbilitySpec* AbilitySpec = FAuraAbilityLatencyTracker::IsEnabled() ? GetCurrentAbilitySpec() : nullptr)
+		{
+			FAuraAbilityLatencyTracker::MarkFirstEffect(GetAbilitySystemComponentFromActorInfo(), UAuraAbilitySystemComponent::GetAbilityTagFromSpec(*AbilitySpec));
+		}
+	}
+
+	if (const FHitResult* HitResult = BeamTraceSubsystem->TraceBeam(BeamTraceSlot, BeamTargetLocation))
+	{
+		if (HitResult->bBlockingHit)
+		{
+			MouseHitLocation = HitResult->ImpactPoint;
+			MouseHitActor = HitResult->GetActor();
+		}
+	}
+}
+
+bool USkillBeam::GetBeamTraceResult(FHitResult& OutHitResult) const
+{
+	if (const USkillBeamTraceSubsystem* BeamTraceSubsystem = GetWorld()->GetSubsystem<USkillBeamTraceSubsystem>())
+	{
+		if (const FHitResult* HitResult = BeamTraceSubsystem->GetBeamResult(BeamTraceSlot))
+		{
+			OutHitResult = *HitResult;
+			return HitResult->bBlockingHit;
+		}
+	}
+	return false;
+}
+
+void USkillBeam::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (BeamTraceSlot != INDEX_NONE)
 	{
-		if (USkeletalMeshComponent* Weapon = ICombatInterface::Execute_GetWeapon(OwnerCharacter))
+		if (USkillBeamTraceSubsystem* BeamTraceSubsystem = GetWorld()->GetSubsystem<USkillBeamTraceSubsystem>())
 		{
-			TArray<AActor*> ActorsToIgnore;
-			ActorsToIgnore.Add(OwnerCharacter);
-			FHitResult HitResult;
-			// TipSocket could be a member variable so we can use this ability on enemy character.
-			const FVector SocketLocation = Weapon->GetSocketLocation(FName("TipSocket"));
-			UKismetSystemLibrary::SphereTraceSingle(
-				OwnerCharacter,
-				SocketLocation,
-				BeamTargetLocation,
-				BeamTraceRadius,
-				TraceTypeQuery1,
-				false,
-				ActorsToIgnore,
-				EDrawDebugTrace::None,
-				HitResult,
-				true);
-
-			if (HitResult.bBlockingHit)
-			{
-				MouseHitLocation = HitResult.ImpactPoint;
-				MouseHitActor = HitResult.GetActor();
-			}
+			BeamTraceSubsystem->UnregisterBeam(BeamTraceSlot);
 		}
+		BeamTraceSlot = INDEX_NONE;
 	}
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
 
 AActor* USkillBeam::FindNextTarget(const FVector& PreviousTargetLocation)
@@ -0,0 +1,108 @@
+// Copyright Nono Studios
+
+
+#include "AbilitySystem/Skills/SkillBeamTraceSubsystem.h"
+
+#include "Engine/SkeletalMeshSocket.h"
+
+void USkillBeamTraceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if (NumAutoRefreshSlots == 0) return;
+
+	const UWorld* World = GetWorld();
+	for (FSkillBeamTraceSlot& Slot : BeamSlots)
+	{
+		if (Slot.bAutoRefresh && Slot.LastTraceFrame != GFrameCounter)
+		{
+			TraceSlot(World, Slot);
+		}
+	}
+}
+
+TStatId USkillBeamTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USkillBeamTraceSubsystem, STATGROUP_Tickables);
+}
+
+int32 USkillBeamTraceSubsystem::RegisterBeam(const UObject* Owner, USkeletalMeshComponent* Weapon, FName SocketName, float Radius, const AActor* IgnoredActor, bool bAutoRefresh)
+{
+	check(Weapon);
+	FSkillBeamTraceSlot Slot;
+	Slot.Owner = Owner;
+	Slot.Weapon = Weapon;
+	// Resolve the socket once, GetSocketLocation would search it by name on every trace.
+	Slot.Socket = Weapon->GetSocketByName(SocketName);
+	Slot.SocketName = SocketName;
+	Slot.Radius = Radius;
+	Slot.bAutoRefresh = bAutoRefresh;
+	NumAutoRefreshSlots += bAutoRefresh ? 1 : 0;
+	Slot.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SkillBeamTrace), false);
+	Slot.QueryParams.bReturnPhysicalMaterial = true;
+	if (IgnoredActor)
+	{
+		Slot.QueryParams.AddIgnoredActor(IgnoredActor);
+	}
+	return BeamSlots.Add(MoveTemp(Slot));
+}
+
+void USkillBeamTraceSubsystem::UnregisterBeam(int32 SlotIndex)
+{
+	if (IsValidSlot(SlotIndex))
+	{
+		NumAutoRefreshSlots -= BeamSlots[SlotIndex].bAutoRefresh ? 1 : 0;
+		BeamSlots.RemoveAt(SlotIndex);
+	}
+}
+
+void USkillBeamTraceSubsystem::AddIgnoredActor(int32 SlotIndex, const AActor* Actor)
+{
+	if (IsValidSlot(SlotIndex) && Actor)
+	{
+		BeamSlots[SlotIndex].QueryParams.AddIgnoredActor(Actor);
+	}
+}
+
+const FHitResult* USkillBeamTraceSubsystem::TraceBeam(int32 SlotIndex, const FVector& TargetLocation)
+{
+	if (!IsValidSlot(SlotIndex)) return nullptr;
+
+	FSkillBeamTraceSlot& Slot = BeamSlots[SlotIndex];
+	const bool bTargetChanged = !Slot.bHasTarget || !Slot.TargetLocation.Equals(TargetLocation);
+	Slot.TargetLocation = TargetLocation;
+	Slot.bHasTarget = true;
+	if (bTargetChanged || Slot.LastTraceFrame != GFrameCounter)
+	{
+		TraceSlot(GetWorld(), Slot);
+	}
+	return Slot.bHasResult ? &Slot.HitResult : nullptr;
+}
+
+const FHitResult* USkillBeamTraceSubsystem::GetBeamResult(int32 SlotIndex) const
+{
+	if (IsValidSlot(SlotIndex) && BeamSlots[SlotIndex].bHasResult)
+	{
+		return &BeamSlots[SlotIndex].HitResult;
+	}
+	return nullptr;
+}
+
+bool USkillBeamTraceSubsystem::IsValidSlot(int32 SlotIndex) const
+{
+	return SlotIndex != INDEX_NONE && BeamSlots.IsValidIndex(SlotIndex);
+}
+
+void USkillBeamTraceSubsystem::TraceSlot(const UWorld* World, FSkillBeamTraceSlot& Slot) const
+{
+	const USkeletalMeshComponent* Weapon = Slot.Weapon.Get();
+	if (!Slot.bHasTarget || Weapon == nullptr || !Slot.Owner.IsValid()) return;
+
+	const USkeletalMeshSocket* Socket = Slot.Socket.Get();
+	const FVector SocketLocation = Socket ? Socket->GetSocketLocation(Weapon) : Weapon->GetSocketLocation(Slot.SocketName);
+
+	// Same query as UKismetSystemLibrary::SphereTraceSingle with TraceTypeQuery1, without the parameters conversion.
+	Slot.HitResult.Reset(1.f, false);
+	World->SweepSingleByChannel(Slot.HitResult, SocketLocation, Slot.TargetLocation, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(Slot.Radius), Slot.QueryParams);
+	Slot.bHasResult = true;
+	Slot.LastTraceFrame = GFrameCounter;
+}
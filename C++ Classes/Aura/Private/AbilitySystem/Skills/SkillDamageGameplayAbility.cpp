@@ -62,6 +62,30 @@ float USkillDamageGameplayAbility::GetTalentsModifiersForAttribute(float OutValu
 	return OutValue;
 }
 
+void USkillDamageGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	// Level and talents may have changed since the last activation.
+	CastDamageEffectParams.Reset();
+	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+}
+
+void USkillDamageGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	CastDamageEffectParams.Reset();
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+FSharedDamageEffectParams USkillDamageGameplayAbility::GetCastDamageEffectParams()
+{
+	if (!CastDamageEffectParams.IsValid())
+	{
+		CastDamageEffectParams = MakeShared<FDamageEffectParams>(MakeDamageEffectParamsFromClassDefaults());
+	}
+	return CastDamageEffectParams;
+}
+
 FDamageEffectParams USkillDamageGameplayAbility::MakeDamageEffectParamsFromClassDefaults(AActor* TargetActor,
 	FVector InRadialDamageOrigin, bool bOverrideKnockbackDirection, FVector InKnockbackDirectionOverride,
 	bool bOverrideDeathImpulse, FVector InDeathImpulseDirectionOverride, bool bOverridePitch, float PitchOverride)
@@ -76,7 +100,7 @@ FDamageEffectParams USkillDamageGameplayAbility::MakeDamageEffectParamsFromClass
 		SetupTalentTree();
 	}
 
-	const FAuraGameplayTags GameplayTags = FAuraGameplayTags::Get();
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
 	Params.BaseDamage = GetTalentsModifiersForAttribute(Params.BaseDamage, Params.DamageType);
 	
 	Params.DebuffChance = GetTalentsModifiersForAttribute(Params.DebuffChance, GameplayTags.Debuff_Chance);
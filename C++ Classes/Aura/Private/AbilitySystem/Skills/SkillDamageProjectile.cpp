@@ -2,7 +2,9 @@
 
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
-#include "Actor/AuraProjectile.h"
+#include "Aura/AuraLogChannels.h"
+#include "Actor/AuraProjectilePoolSubsystem.h"
+#include "Actor/AuraProjectileSpawnSubsystem.h"
 #include "Interaction/CombatInterface.h"
 
 
@@ -13,6 +15,24 @@ void USkillDamageProjectile::ActivateAbility(const FGameplayAbilitySpecHandle Ha
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 }
 
+void USkillDamageProjectile::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	// Abilities are given when the character is possessed, so the pool is ready before the first cast.
+	if (ActorInfo && ActorInfo->IsNetAuthority() && ActorInfo->AvatarActor.IsValid())
+	{
+		if (ProjectileClass && !UAuraProjectilePoolSubsystem::IsPoolable(ProjectileClass))
+		{
+			UE_LOG(LogAura, Warning, TEXT("%s: %s is not poolable, its projectiles are spawned and destroyed on every cast. Parent it to AAuraPooledProjectile."), *GetName(), *ProjectileClass->GetName());
+		}
+		if (UAuraProjectilePoolSubsystem* ProjectilePool = ActorInfo->AvatarActor->GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>())
+		{
+			ProjectilePool->PrewarmPool(ProjectileClass, ProjectilePoolPrewarmCount);
+		}
+	}
+}
+
 void USkillDamageProjectile::SpawnProjectile(const FVector& ProjectileTargetLocation, const FGameplayTag& SocketTag, bool bOverridePitch, float PitchOverride)
 {
 	const bool bIsServer = GetAvatarActorFromActorInfo()->HasAuthority();
@@ -30,16 +50,17 @@ void USkillDamageProjectile::SpawnProjectile(const FVector& ProjectileTargetLoca
 	SpawnTransform.SetLocation(SocketLocation);
 	SpawnTransform.SetRotation(Rotation.Quaternion());
 
+	GetWorld()->GetSubsystem<UAuraProjectileSpawnSubsystem>()->RequestSpawn(MakeProjectileSpawnRequest(SpawnTransform));
+}
 
-	AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
-		ProjectileClass,
-		SpawnTransform,
-		GetOwningActorFromActorInfo(),
-		Cast<APawn>(GetOwningActorFromActorInfo()),
-		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
-	);
-
-	Projectile->DamageEffectParams = MakeDamageEffectParamsFromClassDefaults();
-
-	Projectile->FinishSpawning(SpawnTransform);
+FAuraProjectileSpawnRequest USkillDamageProjectile::MakeProjectileSpawnRequest(const FTransform& SpawnTransform)
+{
+	FAuraProjectileSpawnRequest Request;
+	Request.ProjectileClass = ProjectileClass;
+	Request.SpawnTransform = SpawnTransform;
+	Request.Owner = GetOwningActorFromActorInfo();
+	Request.Instigator = Cast<APawn>(GetOwningActorFromActorInfo());
+	Request.DamageEffectParams = GetCastDamageEffectParams();
+	Request.bSimulateInBatch = bSimulateProjectilesInBatch;
+	return Request;
 }
@@ -0,0 +1,122 @@
+// Copyright Nono Studios
+
+
+#include "Actor/AuraPooledProjectile.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Actor/AuraProjectilePoolSubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Net/UnrealNetwork.h"
+
+void AAuraPooledProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AAuraPooledProjectile, bInPool);
+}
+
+void AAuraPooledProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Prewarmed projectiles are spawned hidden, their looping sound must not play until they are acquired.
+	if (IsHidden() && LoopingSoundComponent)
+	{
+		LoopingSoundComponent->Stop();
+	}
+}
+
+void AAuraPooledProjectile::LifeSpanExpired()
+{
+	if (HasAuthority())
+	{
+		UAuraProjectilePoolSubsystem::ReleaseProjectile(this);
+		return;
+	}
+	Super::LifeSpanExpired();
+}
+
+void AAuraPooledProjectile::OnHit()
+{
+	// The base class destroys its looping sound on hit, keep it for the next use of the projectile.
+	UAudioComponent* LoopingSound = LoopingSoundComponent;
+	LoopingSoundComponent = nullptr;
+	Super::OnHit();
+	LoopingSoundComponent = LoopingSound;
+	if (LoopingSoundComponent)
+	{
+		LoopingSoundComponent->Stop();
+	}
+}
+
+void AAuraPooledProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (bInPool || !IsValidOverlap(OtherActor)) return;
+	// Cosmetic projectiles rebuilt by clients, the server projectile does the hit.
+	if (HasAuthority() && !SharedDamageEffectParams.IsValid()) return;
+	if (!bHit) OnHit();
+
+	if (HasAuthority())
+	{
+		if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OtherActor))
+		{
+			const FDamageEffectTargetParams TargetParams = UAuraAbilitySystemLibrary::MakeDamageEffectTargetParams(*SharedDamageEffectParams, TargetASC, GetActorForwardVector());
+			UAuraAbilitySystemLibrary::ApplySkillDamageEffectToTarget(*SharedDamageEffectParams, TargetParams);
+		}
+		if (VolleyId != 0 && !GetIsReplicated())
+		{
+			if (UAuraAbilitySystemComponent* SourceASC = Cast<UAuraAbilitySystemComponent>(SharedDamageEffectParams->SourceAbilitySystemComponent))
+			{
+				SourceASC->MulticastProjectileImpact(VolleyId, BoltIndex, GetActorLocation());
+			}
+		}
+		UAuraProjectilePoolSubsystem::ReleaseProjectile(this);
+	}
+	else
+	{
+		bHit = true;
+	}
+}
+
+void AAuraPooledProjectile::StopAt(const FVector& ImpactLocation)
+{
+	SetActorLocation(ImpactLocation);
+	if (!bHit) OnHit();
+	UAuraProjectilePoolSubsystem::ReleaseProjectile(this);
+}
+
+void AAuraPooledProjectile::OnAcquiredFromPool_Implementation()
+{
+	bInPool = false;
+	OnRep_InPool();
+}
+
+void AAuraPooledProjectile::OnReleasedToPool_Implementation()
+{
+	SharedDamageEffectParams.Reset();
+	VolleyId = 0;
+	BoltIndex = 0;
+	bInPool = true;
+	OnRep_InPool();
+}
+
+void AAuraPooledProjectile::OnRep_InPool()
+{
+	if (bInPool)
+	{
+		if (LoopingSoundComponent)
+		{
+			LoopingSoundComponent->Stop();
+		}
+		return;
+	}
+
+	bHit = false;
+	if (LoopingSoundComponent)
+	{
+		LoopingSoundComponent->Play();
+	}
+}
@@ -0,0 +1,227 @@
+// Copyright Nono Studios
+
+
+#include "Actor/AuraProjectilePoolSubsystem.h"
+
+#include "AuraAbilityTypes.h"
+#include "Actor/AuraProjectile.h"
+#include "Actor/AuraProjectileSimulationSubsystem.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Interaction/PoolableInterface.h"
+
+static TAutoConsoleVariable<int32> CVarProjectilePoolMaxPerClass(
+	TEXT("Aura.ProjectilePool.MaxPerClass"),
+	64,
+	TEXT("Maximum number of inactive projectiles kept per projectile class. Released projectiles above it are destroyed."));
+
+void UAuraProjectilePoolSubsystem::PrewarmPool(TSubclassOf<AAuraProjectile> ProjectileClass, int32 Count)
+{
+	// Projectiles that destroy themselves would never come back, prewarming them would only add hidden actors.
+	if (!IsPoolable(ProjectileClass)) return;
+
+	FAuraProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	const int32 NumToSpawn = FMath::Min(Count, CVarProjectilePoolMaxPerClass.GetValueOnGameThread()) - Pool.InactiveProjectiles.Num();
+	for (int32 i = 0; i < NumToSpawn; i++)
+	{
+		if (AAuraProjectile* Projectile = SpawnPooledProjectile(ProjectileClass))
+		{
+			ReturnToPool(Projectile);
+		}
+	}
+}
+
+bool UAuraProjectilePoolSubsystem::IsPoolable(TSubclassOf<AAuraProjectile> ProjectileClass)
+{
+	return ProjectileClass && ProjectileClass->ImplementsInterface(UPoolableInterface::StaticClass());
+}
+
+AAuraProjectile* UAuraProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, bool bReplicates)
+{
+	if (FAuraProjectilePool* Pool = Pools.Find(ProjectileClass))
+	{
+		TArray<TObjectPtr<AAuraProjectile>>& InactiveProjectiles = Pool->GetInactiveProjectiles(bReplicates);
+		while (InactiveProjectiles.Num() > 0)
+		{
+			AAuraProjectile* Projectile = InactiveProjectiles.Pop();
+			if (!IsValid(Projectile)) continue;
+
+			Projectile->SetOwner(Owner);
+			Projectile->SetInstigator(Instigator);
+			ResetProjectileState(Projectile);
+			if (Projectile->Implements<UPoolableInterface>())
+			{
+				IPoolableInterface::Execute_OnAcquiredFromPool(Projectile);
+			}
+			return Projectile;
+		}
+	}
+
+	// Pool empty, the deferred spawn is finished in FinishAcquireProjectile.
+	AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
+		ProjectileClass,
+		SpawnTransform,
+		Owner,
+		Instigator,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+	if (Projectile && !bReplicates)
+	{
+		Projectile->SetReplicates(false);
+	}
+	return Projectile;
+}
+
+void UAuraProjectilePoolSubsystem::FinishAcquireProjectile(AAuraProjectile* Projectile, const FTransform& SpawnTransform)
+{
+	check(Projectile);
+	if (!Projectile->HasActorBegunPlay())
+	{
+		// Fresh deferred spawn.
+		Projectile->FinishSpawning(SpawnTransform);
+		Pools.FindOrAdd(Projectile->GetClass()).LifeSpan = Projectile->GetLifeSpan();
+		Projectile->OnDestroyed.AddUniqueDynamic(this, &UAuraProjectilePoolSubsystem::OnPooledProjectileDestroyed);
+		return;
+	}
+
+	if (Projectile->GetIsReplicated())
+	{
+		Projectile->SetNetDormancy(DORM_Awake);
+	}
+	Projectile->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	Projectile->SetActorHiddenInGame(false);
+	Projectile->SetActorEnableCollision(true);
+	Projectile->SetActorTickEnabled(true);
+
+	UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+	Movement->SetUpdatedComponent(Projectile->GetRootComponent());
+	Movement->Velocity = SpawnTransform.GetRotation().Vector() * Movement->InitialSpeed;
+	Movement->UpdateComponentVelocity();
+	Movement->SetComponentTickEnabled(true);
+
+	if (const FAuraProjectilePool* Pool = Pools.Find(Projectile->GetClass()))
+	{
+		Projectile->SetLifeSpan(Pool->LifeSpan);
+	}
+	if (Projectile->GetIsReplicated())
+	{
+		Projectile->ForceNetUpdate();
+	}
+}
+
+void UAuraProjectilePoolSubsystem::ReleaseProjectile(AAuraProjectile* Projectile)
+{
+	if (!IsValid(Projectile)) return;
+
+	UAuraProjectilePoolSubsystem* PoolSubsystem = Projectile->GetWorld() ? Projectile->GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>() : nullptr;
+	if (PoolSubsystem == nullptr || !Projectile->HasAuthority() || !PoolSubsystem->ReturnToPool(Projectile))
+	{
+		Projectile->Destroy();
+	}
+}
+
+USceneComponent* UAuraProjectilePoolSubsystem::AcquireHomingAnchor(AAuraProjectile* Projectile, const FVector& TargetLocation)
+{
+	TObjectPtr<USceneComponent>& Anchor = HomingAnchors.FindOrAdd(Projectile);
+	if (Anchor == nullptr)
+	{
+		Anchor = FreeHomingAnchors.Num() > 0 ? FreeHomingAnchors.Pop() : NewObject<USceneComponent>(this);
+	}
+	Anchor->SetWorldLocation(TargetLocation);
+	return Anchor;
+}
+
+void UAuraProjectilePoolSubsystem::ReleaseHomingAnchor(const AAuraProjectile* Projectile)
+{
+	TObjectPtr<USceneComponent> Anchor;
+	if (HomingAnchors.RemoveAndCopyValue(Projectile, Anchor) && Anchor)
+	{
+		FreeHomingAnchors.Add(Anchor);
+	}
+}
+
+AAuraProjectile* UAuraProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<AAuraProjectile> ProjectileClass)
+{
+	AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
+		ProjectileClass,
+		FTransform::Identity,
+		nullptr,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+	);
+	if (Projectile == nullptr) return nullptr;
+
+	// Hidden, without collision and dormant before BeginPlay, so the first replicated state is already the pooled one
+	// and nothing overlaps at the spawn location.
+	Projectile->SetActorHiddenInGame(true);
+	Projectile->SetActorEnableCollision(false);
+	Projectile->NetDormancy = DORM_DormantAll;
+	Projectile->FinishSpawning(FTransform::Identity);
+
+	Pools.FindOrAdd(ProjectileClass).LifeSpan = Projectile->GetLifeSpan();
+	Projectile->OnDestroyed.AddUniqueDynamic(this, &UAuraProjectilePoolSubsystem::OnPooledProjectileDestroyed);
+	return Projectile;
+}
+
+bool UAuraProjectilePoolSubsystem::ReturnToPool(AAuraProjectile* Projectile)
+{
+	if (!IsPoolable(Projectile->GetClass())) return false;
+
+	TArray<TObjectPtr<AAuraProjectile>>& InactiveProjectiles = Pools.FindOrAdd(Projectile->GetClass()).GetInactiveProjectiles(Projectile->GetIsReplicated());
+	if (InactiveProjectiles.Num() >= CVarProjectilePoolMaxPerClass.GetValueOnGameThread()) return false;
+
+	if (Projectile->Implements<UPoolableInterface>())
+	{
+		IPoolableInterface::Execute_OnReleasedToPool(Projectile);
+	}
+	if (UAuraProjectileSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UAuraProjectileSimulationSubsystem>())
+	{
+		Simulation->RemoveProjectile(Projectile);
+	}
+	ReleaseHomingAnchor(Projectile);
+	DeactivateProjectile(Projectile);
+	InactiveProjectiles.Add(Projectile);
+	return true;
+}
+
+void UAuraProjectilePoolSubsystem::DeactivateProjectile(AAuraProjectile* Projectile) const
+{
+	// Cancel the life span, otherwise the pooled projectile would destroy itself.
+	Projectile->SetLifeSpan(0.f);
+	Projectile->SetActorHiddenInGame(true);
+	Projectile->SetActorEnableCollision(false);
+	Projectile->SetActorTickEnabled(false);
+	Projectile->ProjectileMovement->StopMovementImmediately();
+	Projectile->ProjectileMovement->SetComponentTickEnabled(false);
+
+	// Let the hidden state go out, then stop considering it for replication until it is acquired again.
+	if (Projectile->GetIsReplicated())
+	{
+		Projectile->ForceNetUpdate();
+		Projectile->SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void UAuraProjectilePoolSubsystem::ResetProjectileState(AAuraProjectile* Projectile)
+{
+	const AAuraProjectile* DefaultProjectile = Projectile->GetClass()->GetDefaultObject<AAuraProjectile>();
+	Projectile->DamageEffectParams = FDamageEffectParams();
+
+	UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+	const UProjectileMovementComponent* DefaultMovement = DefaultProjectile->ProjectileMovement;
+	Movement->HomingTargetComponent = nullptr;
+	Movement->bIsHomingProjectile = DefaultMovement->bIsHomingProjectile;
+	Movement->HomingAccelerationMagnitude = DefaultMovement->HomingAccelerationMagnitude;
+	Movement->InitialSpeed = DefaultMovement->InitialSpeed;
+	Movement->MaxSpeed = DefaultMovement->MaxSpeed;
+	Movement->ProjectileGravityScale = DefaultMovement->ProjectileGravityScale;
+}
+
+void UAuraProjectilePoolSubsystem::OnPooledProjectileDestroyed(AActor* DestroyedActor)
+{
+	ReleaseHomingAnchor(Cast<AAuraProjectile>(DestroyedActor));
+	if (FAuraProjectilePool* Pool = Pools.Find(DestroyedActor->GetClass()))
+	{
+		Pool->InactiveProjectiles.RemoveSingleSwap(Cast<AAuraProjectile>(DestroyedActor));
+		Pool->InactiveCosmeticProjectiles.RemoveSingleSwap(Cast<AAuraProjectile>(DestroyedActor));
+	}
+}
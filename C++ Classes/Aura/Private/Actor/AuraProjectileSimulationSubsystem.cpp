@@ -0,0 +1,197 @@
+// Copyright Nono Studios
+
+
+#include "Actor/AuraProjectileSimulationSubsystem.h"
+
+#include "Actor/AuraProjectile.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+static TAutoConsoleVariable<int32> CVarProjectileSimulationBatchSize(
+	TEXT("Aura.ProjectileSimulation.BatchSize"),
+	64,
+	TEXT("Number of projectiles integrated by each ParallelFor task."));
+
+void UAuraProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Drop the projectiles released or destroyed since last frame.
+	for (int32 i = Proxies.Num() - 1; i >= 0; i--)
+	{
+		if (!Proxies[i].IsValid())
+		{
+			RemoveAtSwap(i);
+		}
+	}
+	const int32 NumProjectiles = Proxies.Num();
+	if (NumProjectiles == 0) return;
+
+	// Components can only be read on the game thread, gather the homing locations before going wide.
+	for (int32 i = 0; i < NumProjectiles; i++)
+	{
+		if (const USceneComponent* HomingTarget = HomingTargets[i].Get())
+		{
+			HomingMasks[i] = 1.f;
+			HomingLocations[i] = HomingTarget->GetComponentLocation();
+		}
+		else
+		{
+			HomingMasks[i] = HomesToLocation[i] ? 1.f : 0.f;
+		}
+	}
+
+	const int32 BatchSize = FMath::Max(1, CVarProjectileSimulationBatchSize.GetValueOnGameThread());
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumProjectiles, BatchSize);
+	ParallelFor(NumBatches, [this, BatchSize, NumProjectiles, DeltaTime](int32 BatchIndex)
+	{
+		const int32 Begin = BatchIndex * BatchSize;
+		IntegrateBatch(Begin, FMath::Min(Begin + BatchSize, NumProjectiles), DeltaTime);
+	}, NumBatches == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Sweeping the actors generates their overlaps, which may release projectiles: only null proxies can appear here.
+	for (int32 i = 0; i < NumProjectiles; i++)
+	{
+		AAuraProjectile* Projectile = Proxies[i].Get();
+		if (Projectile == nullptr) continue;
+
+		FHitResult Hit;
+		if (RotationFollowsVelocity[i])
+		{
+			Projectile->SetActorLocationAndRotation(Positions[i], Velocities[i].ToOrientationQuat(), true, &Hit);
+		}
+		else
+		{
+			Projectile->SetActorLocation(Positions[i], true, &Hit);
+		}
+		if (Hit.bBlockingHit && Proxies[i].IsValid())
+		{
+			HandleBlockingHit(i, Hit);
+		}
+
+		// Replicated movement and everything reading GetVelocity() see the simulated velocity, bounces included.
+		if (Proxies[i].IsValid())
+		{
+			UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+			Movement->Velocity = Velocities[i];
+			Movement->UpdateComponentVelocity();
+		}
+	}
+}
+
+TStatId UAuraProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraProjectileSimulationSubsystem::AddProjectile(AAuraProjectile* Projectile, const TOptional<FVector>& HomingLocation)
+{
+	check(Projectile);
+	UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+
+	Proxies.Add(Projectile);
+	Positions.Add(Projectile->GetActorLocation());
+	Velocities.Add(Movement->Velocity);
+	HomingTargets.Add(Movement->bIsHomingProjectile ? Movement->HomingTargetComponent.Get() : nullptr);
+	HomingLocations.Add(HomingLocation.Get(Projectile->GetActorLocation()));
+	HomesToLocation.Add(Movement->bIsHomingProjectile && HomingLocation.IsSet());
+	HomingMasks.Add(0.f);
+	HomingAccelerations.Add(Movement->HomingAccelerationMagnitude);
+	GravityZ.Add(Movement->ShouldApplyGravity() ? Movement->GetGravityZ() : 0.f);
+	MaxSpeeds.Add(Movement->GetMaxSpeed());
+	const bool bSubStep = Movement->bForceSubStepping || GravityZ.Last() != 0.f || (Movement->bIsHomingProjectile && (HomingTargets.Last().IsValid() || HomesToLocation.Last()));
+	MaxTimeSteps.Add(bSubStep ? Movement->MaxSimulationTimeStep : 0.f);
+	MaxIterations.Add(FMath::Max(1, Movement->MaxSimulationIterations));
+	RotationFollowsVelocity.Add(Movement->bRotationFollowsVelocity);
+
+	Movement->SetComponentTickEnabled(false);
+}
+
+void UAuraProjectileSimulationSubsystem::RemoveProjectile(const AAuraProjectile* Projectile)
+{
+	const int32 Index = Proxies.IndexOfByKey(Projectile);
+	if (Index != INDEX_NONE)
+	{
+		Proxies[Index].Reset();
+	}
+}
+
+void UAuraProjectileSimulationSubsystem::IntegrateBatch(int32 Begin, int32 End, float DeltaTime)
+{
+	// Same model as UProjectileMovementComponent: gravity plus homing acceleration, velocity clamped to the max speed.
+	for (int32 i = Begin; i < End; i++)
+	{
+		const int32 NumSteps = MaxTimeSteps[i] > 0.f ? FMath::Clamp(FMath::CeilToInt32(DeltaTime / MaxTimeSteps[i]), 1, MaxIterations[i]) : 1;
+		const float StepTime = DeltaTime / NumSteps;
+		for (int32 Step = 0; Step < NumSteps; Step++)
+		{
+			const FVector ToTarget = HomingLocations[i] - Positions[i];
+			FVector Acceleration = ToTarget.GetSafeNormal() * (HomingAccelerations[i] * HomingMasks[i]);
+			Acceleration.Z += GravityZ[i];
+
+			const FVector OldVelocity = Velocities[i];
+			FVector NewVelocity = OldVelocity + Acceleration * StepTime;
+			const float SpeedSquared = NewVelocity.SizeSquared();
+			const float MaxSpeed = MaxSpeeds[i];
+			if (MaxSpeed > 0.f && SpeedSquared > FMath::Square(MaxSpeed))
+			{
+				NewVelocity *= MaxSpeed * FMath::InvSqrt(SpeedSquared);
+			}
+
+			Positions[i] += (OldVelocity + NewVelocity) * (0.5f * StepTime);
+			Velocities[i] = NewVelocity;
+		}
+	}
+}
+
+void UAuraProjectileSimulationSubsystem::HandleBlockingHit(int32 Index, const FHitResult& Hit)
+{
+	AAuraProjectile* Projectile = Proxies[Index].Get();
+	UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+	Positions[Index] = Projectile->GetActorLocation();
+
+	FVector& Velocity = Velocities[Index];
+	if (Movement->bShouldBounce)
+	{
+		// Same response as UProjectileMovementComponent::ComputeBounceDelta.
+		const float VDotNormal = Velocity | Hit.Normal;
+		if (VDotNormal < 0.f)
+		{
+			const FVector ProjectedNormal = Hit.Normal * -VDotNormal;
+			Velocity += ProjectedNormal;
+			const float TangentSpeed = Velocity.Size();
+			const float ScaledFriction = Movement->bBounceAngleAffectsFriction && TangentSpeed > UE_KINDA_SMALL_NUMBER
+				? FMath::Clamp(-VDotNormal / TangentSpeed, 0.f, 1.f) * Movement->Friction
+				: Movement->Friction;
+			Velocity *= FMath::Clamp(1.f - ScaledFriction, 0.f, 1.f);
+			Velocity += ProjectedNormal * FMath::Max(Movement->Bounciness, 0.f);
+		}
+		if (Velocity.SizeSquared() >= FMath::Square(Movement->BounceVelocityStopSimulatingThreshold))
+		{
+			Movement->OnProjectileBounce.Broadcast(Hit, Velocity);
+			return;
+		}
+	}
+
+	// Hand the projectile back to its movement component, which stops it and notifies OnProjectileStop.
+	Proxies[Index].Reset();
+	Movement->Velocity = Velocity;
+	Movement->StopSimulating(Hit);
+}
+
+void UAuraProjectileSimulationSubsystem::RemoveAtSwap(int32 Index)
+{
+	Proxies.RemoveAtSwap(Index);
+	Positions.RemoveAtSwap(Index);
+	Velocities.RemoveAtSwap(Index);
+	HomingTargets.RemoveAtSwap(Index);
+	HomingLocations.RemoveAtSwap(Index);
+	HomesToLocation.RemoveAtSwap(Index);
+	HomingMasks.RemoveAtSwap(Index);
+	HomingAccelerations.RemoveAtSwap(Index);
+	GravityZ.RemoveAtSwap(Index);
+	MaxSpeeds.RemoveAtSwap(Index);
+	MaxTimeSteps.RemoveAtSwap(Index);
+	MaxIterations.RemoveAtSwap(Index);
+	RotationFollowsVelocity.RemoveAtSwap(Index);
+}
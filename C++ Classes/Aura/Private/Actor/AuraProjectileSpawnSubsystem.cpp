@@ -0,0 +1,224 @@
+// Copyright Nono Studios
+
+
+#include "Actor/AuraProjectileSpawnSubsystem.h"
+
+#include "AbilitySystem/AuraSpreadPatterns.h"
+#include "Actor/AuraPooledProjectile.h"
+#include "Actor/AuraProjectilePoolSubsystem.h"
+#include "Actor/AuraProjectileSimulationSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+static TAutoConsoleVariable<int32> CVarProjectileSpawnMaxPerFrame(
+	TEXT("Aura.ProjectileSpawn.MaxPerFrame"),
+	12,
+	TEXT("Maximum number of skill projectiles spawned in a frame, the others wait for the next frames. 0 means no limit."));
+
+static TAutoConsoleVariable<float> CVarProjectileSpawnBudgetMs(
+	TEXT("Aura.ProjectileSpawn.BudgetMs"),
+	1.f,
+	TEXT("Time in milliseconds a frame can spend spawning skill projectiles. At least one is spawned per frame. 0 means no limit."));
+
+namespace
+{
+	constexpr int32 MaxStoppedVolleyBolts = 256;
+}
+
+void UAuraProjectileSpawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if (PendingRequests.Num() > 0)
+	{
+		DrainPendingRequests();
+	}
+}
+
+TStatId UAuraProjectileSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraProjectileSpawnSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraProjectileSpawnSubsystem::RequestSpawn(FAuraProjectileSpawnRequest&& Request)
+{
+	if (!Request.ProjectileClass) return;
+
+	Request.RequestTime = GetWorld()->GetTimeSeconds() - Request.LaunchDelay;
+	PendingRequests.Add(MoveTemp(Request));
+	DrainPendingRequests();
+}
+
+void UAuraProjectileSpawnSubsystem::SpawnVolley(const FAuraProjectileVolley& Volley, const FAuraProjectileSpawnRequest& Template)
+{
+	// Forget the cosmetic bolts that ended on their own, or whose projectile was reused since.
+	for (auto It = VolleyBolts.CreateIterator(); It; ++It)
+	{
+		const AAuraPooledProjectile* Bolt = Cast<AAuraPooledProjectile>(It.Value().Get());
+		if (Bolt == nullptr || MakeVolleyBoltId(Bolt->VolleyId, Bolt->BoltIndex) != It.Key().Value)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	// Impacts of bolts that never spawned, like those of a lost volley multicast.
+	if (StoppedVolleyBolts.Num() > MaxStoppedVolleyBolts)
+	{
+		StoppedVolleyBolts.Empty();
+	}
+
+	FAuraSpreadDirections Directions;
+	FAuraSpreadPatterns::BuildDirections(EAuraSpreadPattern::Fan, Volley.Forward, FVector::UpVector, Volley.Spread, Volley.NumProjectiles, Directions);
+	FRandomStream RandomStream(Volley.Seed);
+
+	for (int32 BoltIndex = 0; BoltIndex < Directions.Num(); BoltIndex++)
+	{
+		const FRotator Rot = Directions[BoltIndex].Rotation();
+		FAuraProjectileSpawnRequest Request = Template;
+		Request.SpawnTransform = FTransform(Rot.Quaternion(), Volley.Origin);
+		Request.bOverrideHoming = true;
+		Request.bIsHomingProjectile = Volley.bIsHoming;
+		Request.BoltIndex = static_cast<uint8>(BoltIndex);
+		// Always drawn, so the stream stays in sync whatever the bolt targets.
+		Request.HomingAccelerationMagnitude = RandomStream.FRandRange(Volley.HomingAccelerationMin, Volley.HomingAccelerationMax);
+
+		const AActor* BoltTarget = Volley.Targets.IsValidIndex(BoltIndex) ? Volley.Targets[BoltIndex].Get() : nullptr;
+		if (BoltTarget)
+		{
+			Request.HomingTargetComponent = BoltTarget->GetRootComponent();
+			Request.HomingTargetLocation = BoltTarget->GetActorLocation();
+		}
+		else
+		{
+			// No enemy for this bolt, it keeps its place in the fan at the aim distance.
+			Request.HomingTargetLocation = Volley.Origin + Directions[BoltIndex] * Volley.AimDistance;
+		}
+		RequestSpawn(MoveTemp(Request));
+	}
+}
+
+void UAuraProjectileSpawnSubsystem::DrainPendingRequests()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		SpawnedThisFrame = 0;
+		SecondsSpentThisFrame = 0.0;
+	}
+
+	const int32 MaxPerFrame = CVarProjectileSpawnMaxPerFrame.GetValueOnGameThread();
+	const double BudgetSeconds = CVarProjectileSpawnBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Requests are spawned in order, so the bolts of a volley are never overtaken by a later cast.
+	int32 NumSpawned = 0;
+	while (NumSpawned < PendingRequests.Num())
+	{
+		const bool bCountExceeded = MaxPerFrame > 0 && SpawnedThisFrame >= MaxPerFrame;
+		const bool bTimeExceeded = BudgetSeconds > 0.0 && SpawnedThisFrame > 0 && SecondsSpentThisFrame >= BudgetSeconds;
+		if (bCountExceeded || bTimeExceeded) break;
+
+		const double StartTime = FPlatformTime::Seconds();
+		SpawnProjectile(PendingRequests[NumSpawned], Now);
+		SecondsSpentThisFrame += FPlatformTime::Seconds() - StartTime;
+		SpawnedThisFrame++;
+		NumSpawned++;
+	}
+	PendingRequests.RemoveAt(0, NumSpawned);
+}
+
+void UAuraProjectileSpawnSubsystem::StopVolleyBolt(const AActor* Owner, uint16 VolleyId, uint8 BoltIndex, const FVector& ImpactLocation)
+{
+	const FVolleyBoltKey Key(Owner, MakeVolleyBoltId(VolleyId, BoltIndex));
+	TWeakObjectPtr<AAuraProjectile> Bolt;
+	if (!VolleyBolts.RemoveAndCopyValue(Key, Bolt))
+	{
+		StoppedVolleyBolts.Add(Key);
+		return;
+	}
+
+	AAuraPooledProjectile* PooledBolt = Cast<AAuraPooledProjectile>(Bolt.Get());
+	if (PooledBolt && PooledBolt->VolleyId == VolleyId && PooledBolt->BoltIndex == BoltIndex)
+	{
+		PooledBolt->StopAt(ImpactLocation);
+	}
+}
+
+void UAuraProjectileSpawnSubsystem::SpawnProjectile(const FAuraProjectileSpawnRequest& Request, double Now)
+{
+	// The caster may have died while the request was waiting.
+	AActor* Owner = Request.Owner.Get();
+	if (Owner == nullptr) return;
+
+	// Cosmetic bolt whose server bolt already hit.
+	const bool bIsCosmeticVolleyBolt = Request.VolleyId != 0 && !Request.bReplicates;
+	const FVolleyBoltKey VolleyBoltKey(Owner, MakeVolleyBoltId(Request.VolleyId, Request.BoltIndex));
+	if (bIsCosmeticVolleyBolt && StoppedVolleyBolts.Remove(VolleyBoltKey) > 0) return;
+
+	FTransform SpawnTransform = Request.SpawnTransform;
+	const double Delay = Now - Request.RequestTime;
+	if (Delay > 0.0)
+	{
+		// Keep the bolts of a volley level with each other, as if they all left the socket on the requested frame.
+		// The way is swept so a late bolt never starts inside a wall or past what it would have hit.
+		const AAuraProjectile* DefaultProjectile = Request.ProjectileClass->GetDefaultObject<AAuraProjectile>();
+		const FVector Start = SpawnTransform.GetLocation();
+		const FVector End = Start + SpawnTransform.GetRotation().Vector() * DefaultProjectile->ProjectileMovement->InitialSpeed * Delay;
+		const UPrimitiveComponent* Collision = Cast<UPrimitiveComponent>(DefaultProjectile->GetRootComponent());
+
+		FCollisionObjectQueryParams ObjectQueryParams;
+		ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+		ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+		ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSpawnAdvance), false, Owner);
+		if (const APawn* Instigator = Request.Instigator.Get())
+		{
+			QueryParams.AddIgnoredActor(Instigator);
+		}
+
+		FHitResult Hit;
+		const FCollisionShape Shape = Collision ? Collision->GetCollisionShape() : FCollisionShape();
+		const bool bBlocked = GetWorld()->SweepSingleByObjectType(Hit, Start, End, FQuat::Identity, ObjectQueryParams, Shape, QueryParams);
+		SpawnTransform.SetLocation(bBlocked ? Hit.Location : End);
+	}
+
+	UAuraProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>();
+	AAuraProjectile* Projectile = ProjectilePool->AcquireProjectile(Request.ProjectileClass, SpawnTransform, Owner, Request.Instigator.Get(), Request.bReplicates);
+	// Cosmetic projectiles rebuilt by clients have no damage params, the projectile then ignores its overlaps.
+	if (AAuraPooledProjectile* PooledProjectile = Cast<AAuraPooledProjectile>(Projectile))
+	{
+		PooledProjectile->SharedDamageEffectParams = Request.DamageEffectParams;
+		PooledProjectile->VolleyId = Request.VolleyId;
+		PooledProjectile->BoltIndex = Request.BoltIndex;
+		if (bIsCosmeticVolleyBolt)
+		{
+			VolleyBolts.Add(VolleyBoltKey, PooledProjectile);
+		}
+	}
+	else if (Request.DamageEffectParams.IsValid())
+	{
+		Projectile->DamageEffectParams = *Request.DamageEffectParams;
+	}
+
+	// Batch simulated projectiles home to a location directly, the others need an anchor component.
+	TOptional<FVector> HomingLocation;
+	if (Request.bOverrideHoming)
+	{
+		UProjectileMovementComponent* Movement = Projectile->ProjectileMovement;
+		USceneComponent* HomingTarget = Request.HomingTargetComponent.Get();
+		if (HomingTarget == nullptr && Request.bSimulateInBatch)
+		{
+			HomingLocation = Request.HomingTargetLocation;
+		}
+		else
+		{
+			Movement->HomingTargetComponent = HomingTarget ? HomingTarget : ProjectilePool->AcquireHomingAnchor(Projectile, Request.HomingTargetLocation);
+		}
+		Movement->HomingAccelerationMagnitude = Request.HomingAccelerationMagnitude;
+		Movement->bIsHomingProjectile = Request.bIsHomingProjectile;
+	}
+
+	ProjectilePool->FinishAcquireProjectile(Projectile, SpawnTransform);
+	if (Request.bSimulateInBatch)
+	{
+		GetWorld()->GetSubsystem<UAuraProjectileSimulationSubsystem>()->AddProjectile(Projectile, HomingLocation);
+	}
+}
@@ -1,221 +1,258 @@
 #include "AuraAbilityTypes.h"
 
-bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+#include "Profiling/AuraNetProfiler.h"
+
+namespace
 {
-	// RepBits |= 1 << 0;
-	// RepBits = RepBits | 1 << 0
-	uint32 RepBits = 0;
-	if (Ar.IsSaving())
+	// Durations and frequencies to a tenth of a second, up to 6553.5 seconds.
+	void SerializeDeciseconds(FArchive& Ar, float& Value)
 	{
-		if (bReplicateInstigator && Instigator.IsValid())
+		uint16 Quantized = 0;
+		if (Ar.IsSaving())
 		{
-			RepBits |= 1 << 0;
+			Quantized = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Value * 10.f), 0, MAX_uint16));
 		}
-		if (bReplicateEffectCauser && EffectCauser.IsValid() )
+		Ar << Quantized;
+		if (Ar.IsLoading())
 		{
-			RepBits |= 1 << 1;
+			Value = Quantized / 10.f;
 		}
-		if (AbilityCDO.IsValid())
+	}
+
+	// Radii to the unit, up to 65535.
+	void SerializeUnits(FArchive& Ar, float& Value)
+	{
+		uint16 Quantized = 0;
+		if (Ar.IsSaving())
 		{
-			RepBits |= 1 << 2;
+			Quantized = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Value), 0, MAX_uint16));
 		}
-		if (bReplicateSourceObject && SourceObject.IsValid())
+		Ar << Quantized;
+		if (Ar.IsLoading())
 		{
-			RepBits |= 1 << 3;
+			Value = Quantized;
 		}
-		if (Actors.Num() > 0)
+	}
+
+	// Impulses and origins to a tenth of a unit.
+	void SerializeVector10(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, FVector& Value)
+	{
+		FVector_NetQuantize10 Quantized(Value);
+		Quantized.NetSerialize(Ar, Map, bOutSuccess);
+		Value = Quantized;
+	}
+
+	// Tags go through their net index when fast replication is enabled in the gameplay tags settings.
+	void SerializeTag(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, FGameplayTag& Tag)
+	{
+		Tag.NetSerialize(Ar, Map, bOutSuccess);
+	}
+}
+
+TConstArrayView<FAuraGameplayEffectContext::FNetField> FAuraGameplayEffectContext::GetNetSchema()
+{
+	using FContext = FAuraGameplayEffectContext;
+	static const FNetField Schema[] =
+	{
+		// Same fields as FGameplayEffectContext.
 		{
-			RepBits |= 1 << 4;
-		}
-		if (HitResult.IsValid())
+			TEXT("Instigator"),
+			[](const FContext& Context) { return Context.bReplicateInstigator && Context.Instigator.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.Instigator; },
+			nullptr
+		},
 		{
-			RepBits |= 1 << 5;
-		}
-		if (bHasWorldOrigin)
+			TEXT("EffectCauser"),
+			[](const FContext& Context) { return Context.bReplicateEffectCauser && Context.EffectCauser.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.EffectCauser; },
+			nullptr
+		},
 		{
-			RepBits |= 1 << 6;
-		}
-		// Thirteen more custom values for this Class.
-		if (bIsBlockedHit)
+			TEXT("AbilityCDO"),
+			[](const FContext& Context) { return Context.AbilityCDO.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.AbilityCDO; },
+			nullptr
+		},
 		{
-			RepBits |= 1 << 7;
-		}
-		if (bIsCriticalHit)
+			TEXT("SourceObject"),
+			[](const FContext& Context) { return Context.bReplicateSourceObject && Context.SourceObject.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.SourceObject; },
+			nullptr
+		},
 		{
-			RepBits |= 1 << 8;
-		}
-		if (bIsSuccessfulDebuff)
+			TEXT("Actors"),
+			[](const FContext& Context) { return Context.Actors.Num() > 0; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SafeNetSerializeTArray_Default<31>(Ar, Context.Actors); },
+			nullptr
+		},
 		{
-			RepBits |= 1 << 9;
-		}
-		if (DebuffDamage > 0.f)
+			TEXT("HitResult"),
+			[](const FContext& Context) { return Context.HitResult.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+			{
+				if (Ar.IsLoading() && !Context.HitResult.IsValid())
+				{
+					Context.HitResult = MakeShared<FHitResult>();
+				}
+				Context.HitResult->NetSerialize(Ar, Map, bOutSuccess);
+			},
+			nullptr
+		},
 		{
-			RepBits |= 1 << 10;
-		}
-		if (DebuffDuration > 0.f)
+			TEXT("WorldOrigin"),
+			[](const FContext& Context) { return Context.bHasWorldOrigin; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.WorldOrigin; Context.bHasWorldOrigin = true; },
+			[](FContext& Context) { Context.bHasWorldOrigin = false; }
+		},
+
+		// Custom values from the class.
 		{
-			RepBits |= 1 << 11;
-		}
-		if (DebuffFrequency > 0.f)
+			TEXT("bIsBlockedHit"),
+			[](const FContext& Context) { return Context.bIsBlockedHit; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Context.bIsBlockedHit = true; },
+			[](FContext& Context) { Context.bIsBlockedHit = false; }
+		},
 		{
-			RepBits |= 1 << 12;
-		}
-		if (DamageType.IsValid())
+			TEXT("bIsCriticalHit"),
+			[](const FContext& Context) { return Context.bIsCriticalHit; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Context.bIsCriticalHit = true; },
+			[](FContext& Context) { Context.bIsCriticalHit = false; }
+		},
 		{
-			RepBits |= 1 << 13;
-		}
-		if (!DeathImpulse.IsZero())
+			TEXT("bIsSuccessfulDebuff"),
+			[](const FContext& Context) { return Context.bIsSuccessfulDebuff; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Context.bIsSuccessfulDebuff = true; },
+			[](FContext& Context) { Context.bIsSuccessfulDebuff = false; }
+		},
 		{
-			RepBits |= 1 << 14;
-		}
-		if (!KnockbackForce.IsZero())
+			TEXT("DebuffDamage"),
+			[](const FContext& Context) { return Context.DebuffDamage > 0.f; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Ar << Context.DebuffDamage; },
+			[](FContext& Context) { Context.DebuffDamage = 0.f; }
+		},
 		{
-			RepBits |= 1 << 15;
-		}
-		if (bIsRadialDamage)
+			TEXT("DebuffDuration"),
+			[](const FContext& Context) { return Context.DebuffDuration > 0.f; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeDeciseconds(Ar, Context.DebuffDuration); },
+			[](FContext& Context) { Context.DebuffDuration = 0.f; }
+		},
 		{
-			RepBits |= 1 << 16;
-
-			if (RadialDamageInnerRadius > 0.f)
-			{
-				RepBits |= 1 << 17;
-			}
-			if (RadialDamageOuterRadius > 0.f)
-			{
-				RepBits |= 1 << 18;
-			}
-			if (!RadialDamageOrigin.IsZero())
-			{
-				RepBits |= 1 << 19;
-			}
-		}
-		if (SkillTag.IsValid())
+			TEXT("DebuffFrequency"),
+			[](const FContext& Context) { return Context.DebuffFrequency > 0.f; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeDeciseconds(Ar, Context.DebuffFrequency); },
+			[](FContext& Context) { Context.DebuffFrequency = 0.f; }
+		},
 		{
-			RepBits |= 1 << 20;
-		}
-	}
-
-	// We flipped Fourteen more bits compared to the original (7) FAuraGameplayEffectContext of FGameplayEffectContext
-	Ar.SerializeBits(&RepBits, 20);
-
-	if (RepBits & (1 << 0))
-	{
-		Ar << Instigator;
-	}
-	if (RepBits & (1 << 1))
-	{
-		Ar << EffectCauser;
-	}
-	if (RepBits & (1 << 2))
-	{
-		Ar << AbilityCDO;
-	}
-	if (RepBits & (1 << 3))
-	{
-		Ar << SourceObject;
-	}
-	if (RepBits & (1 << 4))
-	{
-		SafeNetSerializeTArray_Default<31>(Ar, Actors);
-	}
-	if (RepBits & (1 << 5))
-	{
-		if (Ar.IsLoading())
+			TEXT("DamageType"),
+			[](const FContext& Context) { return Context.DamageType.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeTag(Ar, Map, bOutSuccess, Context.DamageType); },
+			[](FContext& Context) { Context.DamageType = FGameplayTag(); }
+		},
 		{
-			if (!HitResult.IsValid())
-			{
-				HitResult = TSharedPtr<FHitResult>(new FHitResult());
-			}
-		}
-		HitResult->NetSerialize(Ar, Map, bOutSuccess);
-	}
-	if (RepBits & (1 << 6))
-	{
-		Ar << WorldOrigin;
-		bHasWorldOrigin = true;
-	}
-	else
-	{
-		bHasWorldOrigin = false;
-	}
-	// Custom Values from the Class.
-	if (RepBits & (1 << 7))
-	{
-		Ar << bIsBlockedHit;
-	}
-	if (RepBits & (1 << 8))
-	{
-		Ar << bIsCriticalHit;
-	}
-	if (RepBits & (1 << 9))
-	{
-		Ar << bIsSuccessfulDebuff;
-	}
-	if (RepBits & (1 << 10))
-	{
-		Ar << DebuffDamage;
-	}
-	if (RepBits & (1 << 11))
-	{
-		Ar << DebuffDuration;
-	}
-	if (RepBits & (1 << 12))
-	{
-		Ar << DebuffFrequency;
-	}
-	if (RepBits & (1 << 13))
+			TEXT("DeathImpulse"),
+			[](const FContext& Context) { return !Context.DeathImpulse.IsZero(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeVector10(Ar, Map, bOutSuccess, Context.DeathImpulse); },
+			[](FContext& Context) { Context.DeathImpulse = FVector::ZeroVector; }
+		},
+		{
+			TEXT("KnockbackForce"),
+			[](const FContext& Context) { return !Context.KnockbackForce.IsZero(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeVector10(Ar, Map, bOutSuccess, Context.KnockbackForce); },
+			[](FContext& Context) { Context.KnockbackForce = FVector::ZeroVector; }
+		},
+		{
+			TEXT("bIsRadialDamage"),
+			[](const FContext& Context) { return Context.bIsRadialDamage; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { Context.bIsRadialDamage = true; },
+			[](FContext& Context) { Context.bIsRadialDamage = false; }
+		},
+		{
+			TEXT("RadialDamageInnerRadius"),
+			[](const FContext& Context) { return Context.bIsRadialDamage && Context.RadialDamageInnerRadius > 0.f; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeUnits(Ar, Context.RadialDamageInnerRadius); },
+			[](FContext& Context) { Context.RadialDamageInnerRadius = 0.f; }
+		},
+		{
+			TEXT("RadialDamageOuterRadius"),
+			[](const FContext& Context) { return Context.bIsRadialDamage && Context.RadialDamageOuterRadius > 0.f; },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeUnits(Ar, Context.RadialDamageOuterRadius); },
+			[](FContext& Context) { Context.RadialDamageOuterRadius = 0.f; }
+		},
+		{
+			TEXT("RadialDamageOrigin"),
+			[](const FContext& Context) { return Context.bIsRadialDamage && !Context.RadialDamageOrigin.IsZero(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeVector10(Ar, Map, bOutSuccess, Context.RadialDamageOrigin); },
+			[](FContext& Context) { Context.RadialDamageOrigin = FVector::ZeroVector; }
+		},
+		{
+			TEXT("SkillTag"),
+			[](const FContext& Context) { return Context.SkillTag.IsValid(); },
+			[](FContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { SerializeTag(Ar, Map, bOutSuccess, Context.SkillTag); },
+			[](FContext& Context) { Context.SkillTag = FGameplayTag(); }
+		},
+	};
+	static_assert(UE_ARRAY_COUNT(Schema) <= 32, "The rep bits of FAuraGameplayEffectContext are serialized as a uint32.");
+	return Schema;
+}
+
+bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// One rep bit per field of the schema, so the bits written always match the fields serialized.
+	const TConstArrayView<FNetField> Schema = GetNetSchema();
+	uint32 RepBits = 0;
+	if (Ar.IsSaving())
 	{
-		if (Ar.IsLoading())
+		for (int32 FieldIndex = 0; FieldIndex < Schema.Num(); FieldIndex++)
 		{
-			if (!DamageType.IsValid())
+			if (Schema[FieldIndex].ShouldSerialize(*this))
 			{
-				DamageType = TSharedPtr<FGameplayTag>(new FGameplayTag());
+				RepBits |= 1 << FieldIndex;
 			}
 		}
-		DamageType->NetSerialize(Ar, Map, bOutSuccess);
-	}
-	if (RepBits & (1 << 14))
-	{
-		DeathImpulse.NetSerialize(Ar, Map, bOutSuccess);
 	}
-	if (RepBits & (1 << 15))
+	Ar.SerializeBits(&RepBits, Schema.Num());
+
+	if (Ar.IsSaving() && FAuraNetProfiler::ShouldRecord())
 	{
-		KnockbackForce.NetSerialize(Ar, Map, bOutSuccess);
+		RecordNetProfile(RepBits);
 	}
-	if (RepBits & (1 << 16))
-	{
-		Ar << bIsRadialDamage;
 
-		if (RepBits & (1 << 17))
-		{
-			Ar << RadialDamageInnerRadius;
-		}
-		if (RepBits & (1 << 18))
-		{
-			Ar << RadialDamageOuterRadius;
-		}
-		if (RepBits & (1 << 19))
+	for (int32 FieldIndex = 0; FieldIndex < Schema.Num(); FieldIndex++)
+	{
+		const FNetField& Field = Schema[FieldIndex];
+		if (RepBits & (1 << FieldIndex))
 		{
-			RadialDamageOrigin.NetSerialize(Ar, Map, bOutSuccess);
+			Field.Serialize(*this, Ar, Map, bOutSuccess);
 		}
-	}
-	if (RepBits & (1 << 20))
-	{
-		if (Ar.IsLoading())
+		else if (Ar.IsLoading() && Field.Reset)
 		{
-			if (!SkillTag.IsValid())
-			{
-				SkillTag = TSharedPtr<FGameplayTag>(new FGameplayTag());
-			}
+			Field.Reset(*this);
 		}
-		SkillTag->NetSerialize(Ar, Map, bOutSuccess);
 	}
-	
+
 	if (Ar.IsLoading())
 	{
 		AddInstigator(Instigator.Get(), EffectCauser.Get()); // Just to initialize InstigatorAbilitySystemComponent
-	}	
-	
+	}
+
 	bOutSuccess = true;
 	return true;
-}
\ No newline at end of file
+}
+
+void FAuraGameplayEffectContext::RecordNetProfile(uint32 RepBits)
+{
+	const TConstArrayView<FNetField> Schema = GetNetSchema();
+	FAuraNetProfiler::Record(EAuraNetTraffic::ContextField, TEXT("RepBits"), Schema.Num());
+	for (int32 FieldIndex = 0; FieldIndex < Schema.Num(); FieldIndex++)
+	{
+		if (!(RepBits & (1 << FieldIndex))) continue;
+
+		const FNetField& Field = Schema[FieldIndex];
+		const int64 Bits = FAuraNetProfiler::MeasureBits([this, &Field](FArchive& Ar, UPackageMap* Map)
+		{
+			bool bSuccess = true;
+			Field.Serialize(*this, Ar, Map, bSuccess);
+		});
+		FAuraNetProfiler::Record(EAuraNetTraffic::ContextField, Field.Name, Bits);
+	}
+}
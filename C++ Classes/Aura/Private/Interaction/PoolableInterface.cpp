@@ -0,0 +1,6 @@
+// Copyright Nono Studios
+
+
+#include "Interaction/PoolableInterface.h"
+
+// Add default functionality here for any IPoolableInterface functions that are not pure virtual.
@@ -6,6 +6,8 @@
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "AbilitySystem/BlessingData.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Profiling/AuraNetProfiler.h"
 
 AAuraPlayerState::AAuraPlayerState()
 {
@@ -15,52 +17,116 @@ AAuraPlayerState::AAuraPlayerState()
 	
 	AttributeSet = CreateDefaultSubobject<UAuraAttributeSet>(TEXT("AttributeSet"));
 	
-	NetUpdateFrequency = 100.f;
+	NetUpdateFrequency = ActiveNetUpdateFrequency;
 }
 
 void AAuraPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AAuraPlayerState, Level);
-	DOREPLIFETIME(AAuraPlayerState, XP);
-	DOREPLIFETIME(AAuraPlayerState, AttributePoints);
-	DOREPLIFETIME(AAuraPlayerState, SpellPoints);
-	DOREPLIFETIME(AAuraPlayerState, SkillsTalents);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, Level, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, XP, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, AttributePoints, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, SpellPoints, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, SkillsTalents, Params);
+}
+
+void AAuraPlayerState::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	static const FName ProfiledProperties[] =
+	{
+		GET_MEMBER_NAME_CHECKED(AAuraPlayerState, Level),
+		GET_MEMBER_NAME_CHECKED(AAuraPlayerState, XP),
+		GET_MEMBER_NAME_CHECKED(AAuraPlayerState, AttributePoints),
+		GET_MEMBER_NAME_CHECKED(AAuraPlayerState, SpellPoints),
+		GET_MEMBER_NAME_CHECKED(AAuraPlayerState, SkillsTalents),
+	};
+	FAuraNetProfiler::SampleProperties(this, ProfiledProperties, NetProfilerValues);
+
+	if (NetUpdateFrequency > IdleNetUpdateFrequency && GetWorld()->GetTimeSeconds() - LastReplicatedChangeTime > ActiveNetUpdateSeconds)
+	{
+		NetUpdateFrequency = IdleNetUpdateFrequency;
+	}
+}
+
+void AAuraPlayerState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!HasAuthority()) return;
+
+	// The ability system replicates with the player state, effects added or removed must raise the rate as well.
+	// Periodic executions (regen) and ability activations don't, they would keep the active rate forever, and
+	// activations are replicated by the ability system RPCs.
+	LastReplicatedChangeTime = GetWorld()->GetTimeSeconds();
+	AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddWeakLambda(this, [this](UAbilitySystemComponent*, const FGameplayEffectSpec&, FActiveGameplayEffectHandle)
+	{
+		OnReplicatedStateChanged();
+	});
+	AbilitySystemComponent->OnAnyGameplayEffectRemovedDelegate().AddWeakLambda(this, [this](const FActiveGameplayEffect&)
+	{
+		OnReplicatedStateChanged();
+	});
+}
+
+void AAuraPlayerState::OnReplicatedStateChanged()
+{
+	if (!HasAuthority()) return;
+
+	LastReplicatedChangeTime = GetWorld()->GetTimeSeconds();
+	NetUpdateFrequency = ActiveNetUpdateFrequency;
+	ForceNetUpdate();
 }
 
 void AAuraPlayerState::SetXP(int32 InXP)
 {
 	XP = InXP;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, XP, this);
+	OnReplicatedStateChanged();
 	OnXpChangedDelegate.Broadcast(XP);
 }
 
 void AAuraPlayerState::AddToXP(int32 InXP)
 {
 	XP += InXP;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, XP, this);
+	OnReplicatedStateChanged();
 	OnXpChangedDelegate.Broadcast(XP);
 }
 
 void AAuraPlayerState::SetLevel(int32 InLevel)
 {
 	Level = InLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, Level, this);
+	OnReplicatedStateChanged();
 	OnLevelChangedDelegate.Broadcast(Level);
 }
 
 void AAuraPlayerState::AddToLevel(int32 InLevel)
 {
 	Level += InLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, Level, this);
+	OnReplicatedStateChanged();
 	OnLevelChangedDelegate.Broadcast(Level);
 }
 
 void AAuraPlayerState::AddToAttributePoints(int32 InAttributePoints)
 {
 	AttributePoints += InAttributePoints;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, AttributePoints, this);
+	OnReplicatedStateChanged();
 	OnAttributePointsChangedDelegate.Broadcast(AttributePoints);
 }
 
 void AAuraPlayerState::AddToSpellPoints(int32 InSpellPoints)
 {
 	SpellPoints += InSpellPoints;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, SpellPoints, this);
+	OnReplicatedStateChanged();
 	OnSpellPointsChangedDelegate.Broadcast(SpellPoints);
 }
 
@@ -96,6 +162,8 @@ void AAuraPlayerState::AddNewTalent(const FGameplayTag& TalentTag, const FGamepl
 	{
 		 FSkillTalent NewTalent = TalentData.SkillTalent;
 		 SkillsTalents.Add(NewTalent);
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, SkillsTalents, this);
+		OnReplicatedStateChanged();
 
 		if (IsValid(NewTalent.TalentEffectClass))
 		{
@@ -128,6 +196,8 @@ bool AAuraPlayerState::ChangeTalentLevel(const FGameplayTag& TalentTag, int32 In
 
 	int32 PreviousLevel = Talent->TalentLevel;
 	Talent->TalentLevel += InLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, SkillsTalents, this);
+	OnReplicatedStateChanged();
 	bool DeactivateTalent = false;
 	if (PreviousLevel > 0 &&  Talent->TalentLevel <= 0)
 	{
@@ -196,6 +266,8 @@ void AAuraPlayerState::RemoveTalent(const FGameplayTag& TalentTag)
 		if (SkillTalent.TalentTag == TalentTag)
 		{
 			SkillsTalents.RemoveAt(i);
+			MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, SkillsTalents, this);
+			OnReplicatedStateChanged();
 		}
 		i++;
 	}
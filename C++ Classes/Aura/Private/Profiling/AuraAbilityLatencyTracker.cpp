@@ -0,0 +1,219 @@
+// Copyright Nono Studios
+
+
+#include "Profiling/AuraAbilityLatencyTracker.h"
+
+#include "AbilitySystemComponent.h"
+#include "Aura/AuraLogChannels.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/ObjectKey.h"
+
+DECLARE_STATS_GROUP(TEXT("AuraAbilityLatency"), STATGROUP_AuraAbilityLatency, STATCAT_Advanced);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Local (ms)"), STAT_AuraAbilityLatencyLocal, STATGROUP_AuraAbilityLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Round Trip (ms)"), STAT_AuraAbilityLatencyRoundTrip, STATGROUP_AuraAbilityLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last First Effect (ms)"), STAT_AuraAbilityLatencyFirstEffect, STATGROUP_AuraAbilityLatency);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Samples"), STAT_AuraAbilityLatencySamples, STATGROUP_AuraAbilityLatency);
+
+static TAutoConsoleVariable<bool> CVarAbilityLatencyEnabled(
+	TEXT("Aura.AbilityLatency.Enabled"),
+	false,
+	TEXT("Records the latency of the ability path (input, activation, first projectile or beam trace, server confirmation)."));
+
+static FAutoConsoleCommand AbilityLatencyDumpCsvCommand(
+	TEXT("Aura.AbilityLatency.DumpCsv"),
+	TEXT("Writes the ability latency histograms to Saved/Profiling/AbilityLatency."),
+	FConsoleCommandDelegate::CreateStatic(&FAuraAbilityLatencyTracker::DumpCsv));
+
+static FAutoConsoleCommand AbilityLatencyResetCommand(
+	TEXT("Aura.AbilityLatency.Reset"),
+	TEXT("Clears the ability latency histograms."),
+	FConsoleCommandDelegate::CreateStatic(&FAuraAbilityLatencyTracker::Reset));
+
+namespace
+{
+	// Presses not followed by an activation (cooldown, no mana...) are ignored past this, so an activation
+	// without input, like a passive, never picks up an old press.
+	constexpr double MaxPendingSeconds = 2.0;
+
+	using FLatencyKey = TPair<FObjectKey, FGameplayTag>;
+	using FLatencyHistograms = TStaticArray<FAuraLatencyHistogram, static_cast<int32>(EAuraAbilityLatency::Num)>;
+
+	TMap<FLatencyKey, double> InputPressTimes;
+	TMap<FLatencyKey, double> ActivationTimes;
+	TMap<FGameplayTag, FLatencyHistograms> Histograms;
+
+	// Entries of destroyed components or of presses that never led anywhere would otherwise stay for the session.
+	void RemoveStaleTimes(TMap<FLatencyKey, double>& Times, double Now)
+	{
+		for (auto It = Times.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value() > MaxPendingSeconds)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	const TCHAR* GetLatencyName(EAuraAbilityLatency Kind)
+	{
+		switch (Kind)
+		{
+		case EAuraAbilityLatency::Local: return TEXT("Local");
+		case EAuraAbilityLatency::RoundTrip: return TEXT("RoundTrip");
+		case EAuraAbilityLatency::FirstEffect: return TEXT("FirstEffect");
+		default: return TEXT("Unknown");
+		}
+	}
+}
+
+const float FAuraLatencyHistogram::BucketUpperBoundsMs[NumBuckets - 1] = {5.f, 10.f, 16.f, 33.f, 50.f, 66.f, 100.f, 150.f, 200.f, 300.f, 500.f, 1000.f};
+
+void FAuraLatencyHistogram::AddSample(float LatencyMs)
+{
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && LatencyMs > BucketUpperBoundsMs[BucketIndex])
+	{
+		BucketIndex++;
+	}
+	Buckets[BucketIndex]++;
+
+	MinMs = Count == 0 ? LatencyMs : FMath::Min(MinMs, LatencyMs);
+	MaxMs = Count == 0 ? LatencyMs : FMath::Max(MaxMs, LatencyMs);
+	SumMs += LatencyMs;
+	Count++;
+}
+
+float FAuraLatencyHistogram::GetPercentileMs(float Percentile) const
+{
+	if (Count == 0) return 0.f;
+
+	const int32 TargetCount = FMath::CeilToInt(Percentile * Count);
+	int32 CumulatedCount = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; BucketIndex++)
+	{
+		CumulatedCount += Buckets[BucketIndex];
+		if (CumulatedCount >= TargetCount)
+		{
+			return FMath::Min(BucketUpperBoundsMs[BucketIndex], MaxMs);
+		}
+	}
+	return MaxMs;
+}
+
+void FAuraAbilityLatencyTracker::MarkInputPressed(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag)
+{
+	if (!IsEnabled() || !AbilityTag.IsValid()) return;
+	InputPressTimes.Add(FLatencyKey(AbilitySystemComponent, AbilityTag), FPlatformTime::Seconds());
+}
+
+void FAuraAbilityLatencyTracker::MarkActivated(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag, FPredictionKey ActivationPredictionKey)
+{
+	if (!IsEnabled() || !AbilityTag.IsValid()) return;
+
+	const double Now = FPlatformTime::Seconds();
+	const FLatencyKey Key(AbilitySystemComponent, AbilityTag);
+	RemoveStaleTimes(InputPressTimes, Now);
+	RemoveStaleTimes(ActivationTimes, Now);
+
+	// Only activations following an input press are tracked, so AI and passive activations add nothing.
+	double PressTime = 0.0;
+	if (!InputPressTimes.RemoveAndCopyValue(Key, PressTime)) return;
+	ActivationTimes.Add(Key, Now);
+	AddSample(AbilityTag, EAuraAbilityLatency::Local, Now - PressTime);
+
+	// Caught up when the server has answered, whether it accepted or rejected the activation.
+	if (!AbilitySystemComponent->IsOwnerActorAuthoritative() && ActivationPredictionKey.IsValidKey())
+	{
+		ActivationPredictionKey.NewCaughtUpDelegate().BindLambda([AbilityTag, PressTime]()
+		{
+			if (IsEnabled())
+			{
+				AddSample(AbilityTag, EAuraAbilityLatency::RoundTrip, FPlatformTime::Seconds() - PressTime);
+			}
+		});
+	}
+}
+
+void FAuraAbilityLatencyTracker::MarkFirstEffect(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag)
+{
+	if (!IsEnabled() || !AbilityTag.IsValid()) return;
+
+	double ActivationTime = 0.0;
+	const double Now = FPlatformTime::Seconds();
+	if (ActivationTimes.RemoveAndCopyValue(FLatencyKey(AbilitySystemComponent, AbilityTag), ActivationTime) && Now - ActivationTime <= MaxPendingSeconds)
+	{
+		AddSample(AbilityTag, EAuraAbilityLatency::FirstEffect, Now - ActivationTime);
+	}
+}
+
+void FAuraAbilityLatencyTracker::DumpCsv()
+{
+	FString Csv = TEXT("AbilityTag,Latency,Count,AvgMs,MinMs,MaxMs,P50Ms,P95Ms");
+	for (int32 BucketIndex = 0; BucketIndex < FAuraLatencyHistogram::NumBuckets - 1; BucketIndex++)
+	{
+		Csv += FString::Printf(TEXT(",<=%.0fms"), FAuraLatencyHistogram::BucketUpperBoundsMs[BucketIndex]);
+	}
+	Csv += FString::Printf(TEXT(",>%.0fms\n"), FAuraLatencyHistogram::BucketUpperBoundsMs[FAuraLatencyHistogram::NumBuckets - 2]);
+
+	for (const TPair<FGameplayTag, FLatencyHistograms>& AbilityHistograms : Histograms)
+	{
+		for (int32 KindIndex = 0; KindIndex < static_cast<int32>(EAuraAbilityLatency::Num); KindIndex++)
+		{
+			const FAuraLatencyHistogram& Histogram = AbilityHistograms.Value[KindIndex];
+			if (Histogram.Count == 0) continue;
+
+			Csv += FString::Printf(TEXT("%s,%s,%d,%.2f,%.2f,%.2f,%.2f,%.2f"),
+				*AbilityHistograms.Key.ToString(),
+				GetLatencyName(static_cast<EAuraAbilityLatency>(KindIndex)),
+				Histogram.Count,
+				Histogram.SumMs / Histogram.Count,
+				Histogram.MinMs,
+				Histogram.MaxMs,
+				Histogram.GetPercentileMs(0.5f),
+				Histogram.GetPercentileMs(0.95f));
+			for (const int32 BucketCount : Histogram.Buckets)
+			{
+				Csv += FString::Printf(TEXT(",%d"), BucketCount);
+			}
+			Csv += TEXT("\n");
+		}
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("AbilityLatency") / FString::Printf(TEXT("AbilityLatency-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogAura, Display, TEXT("Ability latency written to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+	}
+	else
+	{
+		UE_LOG(LogAura, Error, TEXT("Failed to write ability latency to %s"), *FilePath);
+	}
+}
+
+void FAuraAbilityLatencyTracker::Reset()
+{
+	InputPressTimes.Empty();
+	ActivationTimes.Empty();
+	Histograms.Empty();
+}
+
+void FAuraAbilityLatencyTracker::AddSample(const FGameplayTag& AbilityTag, EAuraAbilityLatency Kind, double Seconds)
+{
+	const float LatencyMs = static_cast<float>(Seconds * 1000.0);
+	Histograms.FindOrAdd(AbilityTag)[static_cast<int32>(Kind)].AddSample(LatencyMs);
+
+	switch (Kind)
+	{
+	case EAuraAbilityLatency::Local: SET_FLOAT_STAT(STAT_AuraAbilityLatencyLocal, LatencyMs); break;
+	case EAuraAbilityLatency::RoundTrip: SET_FLOAT_STAT(STAT_AuraAbilityLatencyRoundTrip, LatencyMs); break;
+	case EAuraAbilityLatency::FirstEffect: SET_FLOAT_STAT(STAT_AuraAbilityLatencyFirstEffect, LatencyMs); break;
+	default: break;
+	}
+	INC_DWORD_STAT(STAT_AuraAbilityLatencySamples);
+}
+
+bool FAuraAbilityLatencyTracker::IsEnabled()
+{
+	return CVarAbilityLatencyEnabled.GetValueOnGameThread();
+}
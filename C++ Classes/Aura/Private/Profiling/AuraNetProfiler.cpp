@@ -0,0 +1,243 @@
+// Copyright Nono Studios
+
+
+#include "Profiling/AuraNetProfiler.h"
+
+#include "Aura/AuraLogChannels.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/Actor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/RepLayout.h"
+#include "UObject/StrongObjectPtr.h"
+
+static TAutoConsoleVariable<bool> CVarNetProfilerEnabled(
+	TEXT("Aura.NetProfiler.Enabled"),
+	false,
+	TEXT("Records the size of the GAS RPCs, replicated player state properties and effect context fields sent by this machine."));
+
+static FAutoConsoleCommand NetProfilerDumpCsvCommand(
+	TEXT("Aura.NetProfiler.DumpCsv"),
+	TEXT("Writes the recorded network traffic, per second and averaged, to Saved/Profiling/NetProfiler."),
+	FConsoleCommandDelegate::CreateStatic(&FAuraNetProfiler::DumpCsv));
+
+static FAutoConsoleCommand NetProfilerResetCommand(
+	TEXT("Aura.NetProfiler.Reset"),
+	TEXT("Clears the recorded network traffic."),
+	FConsoleCommandDelegate::CreateStatic(&FAuraNetProfiler::Reset));
+
+namespace
+{
+	struct FNetTrafficCounts
+	{
+		int64 Bits = 0;
+		int32 Messages = 0;
+	};
+
+	using FNetTrafficKey = TPair<EAuraNetTraffic, FName>;
+
+	// One map per second since StartSeconds.
+	TArray<TMap<FNetTrafficKey, FNetTrafficCounts>> TrafficPerSecond;
+	double StartSeconds = 0.0;
+	bool bIsMeasuring = false;
+
+	UPackageMap* GetMeasurePackageMap()
+	{
+		static TStrongObjectPtr<UAuraNetProfilerPackageMap> PackageMap;
+		if (!PackageMap.IsValid())
+		{
+			PackageMap.Reset(NewObject<UAuraNetProfilerPackageMap>());
+		}
+		return PackageMap.Get();
+	}
+
+	// NetSerializeItem is fatal on arrays and on structs without native NetSerialize, they are walked down to their leaves.
+	void MeasureProperty(FNetBitWriter& Writer, const FProperty* Property, void* Data)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+			uint16 NumElements = static_cast<uint16>(ArrayHelper.Num());
+			Writer << NumElements;
+			for (int32 i = 0; i < ArrayHelper.Num(); i++)
+			{
+				MeasureProperty(Writer, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i));
+			}
+			return;
+		}
+
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty && !(StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative))
+		{
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				if (It->HasAnyPropertyFlags(CPF_RepSkip)) continue;
+				for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ArrayIndex++)
+				{
+					MeasureProperty(Writer, *It, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex));
+				}
+			}
+			return;
+		}
+
+		// Maps and sets can't be replicated.
+		if (Property->IsA<FMapProperty>() || Property->IsA<FSetProperty>()) return;
+
+		Property->NetSerializeItem(Writer, Writer.PackageMap, Data);
+	}
+
+	const TCHAR* GetTrafficName(EAuraNetTraffic Category)
+	{
+		switch (Category)
+		{
+		case EAuraNetTraffic::Rpc: return TEXT("Rpc");
+		case EAuraNetTraffic::Property: return TEXT("Property");
+		case EAuraNetTraffic::ContextField: return TEXT("ContextField");
+		default: return TEXT("Unknown");
+		}
+	}
+}
+
+bool UAuraNetProfilerPackageMap::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	uint32 Placeholder = 0;
+	Ar << Placeholder;
+	return true;
+}
+
+bool FAuraNetProfiler::ShouldRecord()
+{
+	return !bIsMeasuring && CVarNetProfilerEnabled.GetValueOnGameThread();
+}
+
+void FAuraNetProfiler::RecordRpc(const AActor* Actor, UFunction* Function, void* Parameters)
+{
+	if (!ShouldRecord() || Actor == nullptr || Function == nullptr) return;
+
+	UNetDriver* NetDriver = Actor->GetNetDriver();
+	if (NetDriver == nullptr) return;
+
+	// The rep layout only reads the channel's connection, any channel of the actor will do for a multicast.
+	UNetConnection* Connection = Actor->GetNetConnection();
+	if (Connection == nullptr && NetDriver->ClientConnections.Num() > 0)
+	{
+		Connection = NetDriver->ClientConnections[0];
+	}
+	UActorChannel* Channel = Connection ? Connection->FindActorChannelRef(Actor) : nullptr;
+	// No channel, the RPC is not sent.
+	if (Channel == nullptr) return;
+
+	const TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
+	if (!RepLayout.IsValid()) return;
+
+	TGuardValue<bool> MeasuringGuard(bIsMeasuring, true);
+	FNetBitWriter Writer(GetMeasurePackageMap(), 0);
+	RepLayout->SendPropertiesForRPC(Function, Channel, Writer, Parameters);
+	Record(EAuraNetTraffic::Rpc, Function->GetFName(), Writer.GetNumBits());
+}
+
+void FAuraNetProfiler::SampleProperties(const AActor* Actor, TConstArrayView<FName> PropertyNames, TMap<FName, TArray<uint8>>& InOutLastValues)
+{
+	if (!ShouldRecord() || Actor == nullptr) return;
+
+	const UNetDriver* NetDriver = Actor->GetNetDriver();
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	if (NumConnections == 0) return;
+
+	for (const FName& PropertyName : PropertyNames)
+	{
+		const FProperty* Property = Actor->GetClass()->FindPropertyByName(PropertyName);
+		if (Property == nullptr) continue;
+
+		TGuardValue<bool> MeasuringGuard(bIsMeasuring, true);
+		FNetBitWriter Writer(GetMeasurePackageMap(), 0);
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+		{
+			MeasureProperty(Writer, Property, const_cast<void*>(Property->ContainerPtrToValuePtr<void>(Actor, ArrayIndex)));
+		}
+
+		TArray<uint8>& LastValue = InOutLastValues.FindOrAdd(PropertyName);
+		const TArray<uint8>& Value = *Writer.GetBuffer();
+		if (LastValue == Value) continue;
+
+		LastValue = Value;
+		// Player states are relevant to every connection, each one gets the new value.
+		Record(EAuraNetTraffic::Property, PropertyName, Writer.GetNumBits() * NumConnections, NumConnections);
+	}
+}
+
+int64 FAuraNetProfiler::MeasureBits(TFunctionRef<void(FArchive& Ar, UPackageMap* Map)> Serialize)
+{
+	TGuardValue<bool> MeasuringGuard(bIsMeasuring, true);
+	FNetBitWriter Writer(GetMeasurePackageMap(), 0);
+	Serialize(Writer, Writer.PackageMap);
+	return Writer.GetNumBits();
+}
+
+void FAuraNetProfiler::Record(EAuraNetTraffic Category, FName Name, int64 Bits, int32 Messages)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (TrafficPerSecond.IsEmpty())
+	{
+		StartSeconds = Now;
+	}
+	const int32 Second = FMath::FloorToInt32(Now - StartSeconds);
+	if (Second >= TrafficPerSecond.Num())
+	{
+		TrafficPerSecond.SetNum(Second + 1);
+	}
+
+	FNetTrafficCounts& Counts = TrafficPerSecond[Second].FindOrAdd(FNetTrafficKey(Category, Name));
+	Counts.Bits += Bits;
+	Counts.Messages += Messages;
+}
+
+void FAuraNetProfiler::DumpCsv()
+{
+	FString Csv = TEXT("Second,Category,Name,Messages,Bytes\n");
+	TMap<FNetTrafficKey, FNetTrafficCounts> Totals;
+	for (int32 Second = 0; Second < TrafficPerSecond.Num(); Second++)
+	{
+		for (const TPair<FNetTrafficKey, FNetTrafficCounts>& Traffic : TrafficPerSecond[Second])
+		{
+			Csv += FString::Printf(TEXT("%d,%s,%s,%d,%.1f\n"),
+				Second,
+				GetTrafficName(Traffic.Key.Key),
+				*Traffic.Key.Value.ToString(),
+				Traffic.Value.Messages,
+				Traffic.Value.Bits / 8.0);
+
+			FNetTrafficCounts& Total = Totals.FindOrAdd(Traffic.Key);
+			Total.Bits += Traffic.Value.Bits;
+			Total.Messages += Traffic.Value.Messages;
+		}
+	}
+
+	// Averages over the whole recording, seconds without traffic included.
+	const double NumSeconds = FMath::Max(1, TrafficPerSecond.Num());
+	for (const TPair<FNetTrafficKey, FNetTrafficCounts>& Total : Totals)
+	{
+		Csv += FString::Printf(TEXT("PerSecond,%s,%s,%.2f,%.1f\n"),
+			GetTrafficName(Total.Key.Key),
+			*Total.Key.Value.ToString(),
+			Total.Value.Messages / NumSeconds,
+			Total.Value.Bits / 8.0 / NumSeconds);
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("NetProfiler") / FString::Printf(TEXT("NetProfiler-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogAura, Display, TEXT("Network traffic written to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+	}
+	else
+	{
+		UE_LOG(LogAura, Error, TEXT("Failed to write network traffic to %s"), *FilePath);
+	}
+}
+
+void FAuraNetProfiler::Reset()
+{
+	TrafficPerSecond.Empty();
+}
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "AuraAbilityTypes.h"
 #include "AuraAbilitySystemComponent.generated.h"
 
 struct FTalentData;
+class UAbilityInfo;
 struct FAuraAbilityInfo;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FEffectAssetTags, const FGameplayTagContainer& /*AssetTags*/);
@@ -17,6 +19,71 @@ DECLARE_MULTICAST_DELEGATE_FourParams(FAbilityEquippedSignature, const FGameplay
 DECLARE_MULTICAST_DELEGATE_OneParam(FDeactivatePassiveAbilitySignature, const FGameplayTag& /*AbilityTag*/);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FActivatePassiveEffectSignature, const FGameplayTag& /*AbilityTag*/, bool/*bActivate*/);
 
+// Position of a spec in ActivatableAbilities, the handle tells if the index is still the right one.
+struct FAuraAbilitySpecIndex
+{
+	FGameplayAbilitySpecHandle Handle;
+	int32 Index = INDEX_NONE;
+};
+
+// Tags of a spec, resolved once from its ability tags and DynamicAbilityTags, which are both known by clients.
+struct FAuraAbilitySpecTags
+{
+	FGameplayTag AbilityTag;
+	FGameplayTag InputTag;
+	FGameplayTag StatusTag;
+	bool bIsPassive = false;
+	// ReplicationKey of the spec when the tags were resolved, MarkAbilitySpecDirty increments it.
+	int32 SpecReplicationKey = INDEX_NONE;
+};
+
+// Specs bound to one input tag. There is normally only one, equipping an ability clears the slot first.
+struct FAuraInputSlot
+{
+	TArray<FAuraAbilitySpecIndex, TInlineAllocator<1>> Specs;
+};
+
+// Status, level or slot change of an ability, sent to the owning client with the others of its batch.
+USTRUCT()
+struct FAuraAbilityUpdate
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag AbilityTag = FGameplayTag();
+
+	UPROPERTY()
+	FGameplayTag StatusTag = FGameplayTag();
+
+	UPROPERTY()
+	int32 AbilityLevel = 0;
+
+	// Equip updates broadcast AbilityEquippedDelegate with the slots, the others AbilityStatusChangedDelegate with the level.
+	UPROPERTY()
+	bool bIsEquip = false;
+
+	UPROPERTY()
+	FGameplayTag SelectedSlot = FGameplayTag();
+
+	UPROPERTY()
+	FGameplayTag PreviousSlot = FGameplayTag();
+};
+
+// Asset tags of the effects applied to self during a frame, sent to the owning client in a single RPC.
+USTRUCT()
+struct FAuraEffectAssetTagsBatch
+{
+	GENERATED_BODY()
+
+	// Tags of every applied effect, one effect after the other.
+	UPROPERTY()
+	TArray<FGameplayTag> Tags;
+
+	// Number of tags of each applied effect.
+	UPROPERTY()
+	TArray<uint8> EffectTagCounts;
+};
+
 /**
  * 
  */
@@ -54,11 +121,26 @@ public:
 	static bool AbilityHasAnySlot(const FGameplayAbilitySpec& Spec);
 	FGameplayAbilitySpec* GetSpecWithSlot(const FGameplayTag& Slot);
 	bool IsPassiveAbility(const FGameplayAbilitySpec& Spec) const;
-	static void AssignSlotToAbility(FGameplayAbilitySpec& Spec, const FGameplayTag& Slot);
+
+	// Cached until the spec is marked dirty, by MarkAbilitySpecDirty or MarkSpecDirty, its slot changes or abilities replicate.
+	FAuraAbilitySpecTags GetSpecTags(const FGameplayAbilitySpec& Spec) const;
+	// MarkAbilitySpecDirty that also drops the cached tags of the spec, to be used when its DynamicAbilityTags change.
+	void MarkSpecDirty(FGameplayAbilitySpec& Spec, bool bWasAddOrRemove = false);
+	void AssignSlotToAbility(FGameplayAbilitySpec& Spec, const FGameplayTag& Slot);
 
 	UFUNCTION(NetMulticast, Unreliable)
 	void MultiCastActivatePassiveEffect(const FGameplayTag& AbilityTag, bool bActivate);
 
+	// Clients spawn cosmetic bolts for a volley fired by the avatar on the server.
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileVolley(const FAuraProjectileVolley& Volley);
+
+	// A server bolt of a replicated volley hit something, clients stop their cosmetic bolt at the same place.
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastProjectileImpact(uint16 VolleyId, uint8 BoltIndex, FVector_NetQuantize ImpactLocation);
+
+	uint16 MakeProjectileVolleyId();
+
 	FGameplayAbilitySpec* GetSpecFromAbilityTag(const FGameplayTag& AbilityTag);
 
 	UFUNCTION(BlueprintCallable)
@@ -75,12 +157,19 @@ public:
 	UFUNCTION(Server, Reliable)
 	void ServerEquipAbility(const FGameplayTag& AbilityTag, const FGameplayTag& SelectedSlot);
 
-	UFUNCTION(Client, Reliable)
-	void ClientEquipAbility(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag, const FGameplayTag& SelectedSlot, const FGameplayTag& PreviousSlot);
+	/*
+	 * Ability update batch. Status, level and slot changes are queued while a FAuraScopedAbilityUpdate is alive, and sent
+	 * with a single ClientApplyAbilityUpdates when the outermost one ends, after one dirty pass over the changed specs.
+	 * Without an open batch they are sent right away.
+	 */
+	void QueueAbilityStatusUpdate(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag, int32 AbilityLevel);
+	void QueueAbilityEquipUpdate(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag, const FGameplayTag& SelectedSlot, const FGameplayTag& PreviousSlot);
+	// Drops the cached tags of the spec now, MarkAbilitySpecDirty is called once when the batch is flushed.
+	void QueueSpecDirty(FGameplayAbilitySpec& Spec);
 
 	bool GetDescriptionsByAbilityTag(const FGameplayTag& AbilityTag, FString& OutDescription, FString& OutNextLevelDescription);
 
-	static void ClearSlot(FGameplayAbilitySpec* Spec);
+	void ClearSlot(FGameplayAbilitySpec* Spec);
 	void ClearAbilitiesOfSlot(const FGameplayTag& Slot);
 	static bool AbilityHasSlot(FGameplayAbilitySpec* Spec, const FGameplayTag& Slot);
 
@@ -92,13 +181,115 @@ public:
 	void ServerHandleTalent(const FGameplayTag& AbilityTag, const FGameplayTag& TalentTag, TSubclassOf<UGameplayEffect> TalentGameplayEffect, bool DeactivateTalent);
 	
 protected:
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
+	// Every RPC of the component, ours and the engine ones, goes through here to the net profiler.
+	virtual bool CallRemoteFunction(UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack) override;
 	virtual void OnRep_ActivateAbilities() override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
+	void OnEffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
 
 	//RPC pour replication
 	UFUNCTION(Client, Reliable)
-	void ClientEffectApplied(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
+	void ClientEffectsApplied(const FAuraEffectAssetTagsBatch& Batch);
 
 	//RPC pour replication
 	UFUNCTION(Client, Reliable)
-	void ClientUpdateAbilityStatus(const FGameplayTag& AbilityTag, const FGameplayTag& StatusTag, const int32 AbilityLevel);
+	void ClientApplyAbilityUpdates(const TArray<FAuraAbilityUpdate>& Updates);
+
+private:
+	friend struct FAuraScopedAbilityUpdate;
+	void FlushAbilityUpdates();
+	int32 AbilityUpdateBatchDepth = 0;
+	TArray<FAuraAbilityUpdate> PendingAbilityUpdates;
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> PendingDirtySpecs;
+
+	int32 GetAbilitySpecIndex(const FGameplayAbilitySpec& AbilitySpec) const;
+	void IndexAbilitySpec(const FGameplayAbilitySpec& AbilitySpec, int32 Index);
+	void RebuildAbilityTagMap();
+
+	// Every ability tag of the given abilities, and all their parents, to the first spec having it.
+	TMap<FGameplayTag, FAuraAbilitySpecIndex> AbilityTagToSpec;
+	bool bAbilityTagMapDirty = true;
+
+	// Index of InputTag in InputSlots, INDEX_NONE if it is not an ability input.
+	static int32 GetInputSlotIndex(const FGameplayTag& InputTag);
+	// Slot of InputTag with every entry pointing to a valid spec, nullptr if InputTag is not an ability input.
+	const FAuraInputSlot* GetInputSlot(const FGameplayTag& InputTag);
+	void RebuildInputSlots();
+
+	void InvalidateSpecTags(const FGameplayAbilitySpec& Spec) { SpecTagsCache.Remove(Spec.Handle); }
+	mutable TMap<FGameplayAbilitySpecHandle, FAuraAbilitySpecTags> SpecTagsCache;
+
+	static constexpr int32 NumInputSlots = 8;
+	TStaticArray<FAuraInputSlot, NumInputSlots> InputSlots;
+	bool bInputSlotsDirty = true;
+
+	/*
+	 * Held inputs readiness. A bit is set when the ability of the slot can't be activated (cooldown, cost, blocking tags),
+	 * and held inputs stop trying until something that could change it happens.
+	 */
+	void RegisterActivationReadinessEvents();
+	void ResetActivationReadiness() { ActivationNotReadySlots = 0; }
+	void OnReadinessTagChanged(const FGameplayTag Tag, int32 NewCount) { ResetActivationReadiness(); }
+	void OnReadinessManaChanged(const FOnAttributeChangeData& Data) { ResetActivationReadiness(); }
+	void OnReadinessAbilityEnded(UGameplayAbility* Ability) { ResetActivationReadiness(); }
+	// Activation blocked and required tags (Debuff.Stun...) mostly come and go with effects.
+	void OnReadinessEffectApplied(UAbilitySystemComponent* ASC, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle) { ResetActivationReadiness(); }
+	void OnReadinessEffectRemoved(const FActiveGameplayEffect& Effect) { ResetActivationReadiness(); }
+
+	// Effects applied to self are gathered here and sent once per frame.
+	void FlushAppliedEffectTags();
+	FAuraEffectAssetTagsBatch PendingEffectAssetTags;
+
+	// Active effect of every talent applied by ServerHandleTalent, so it's found without querying all the active effects.
+	// TalentTagsByEffect is the reverse map, kept in sync, so removed effects are matched without a scan.
+	TMap<FGameplayTag, FActiveGameplayEffectHandle> TalentEffectHandles;
+	TMap<FActiveGameplayEffectHandle, FGameplayTag> TalentTagsByEffect;
+	FActiveGameplayEffectHandle FindTalentEffectHandle(const FGameplayTag& TalentTag);
+	void AddTalentEffectHandle(const FGameplayTag& TalentTag, const FActiveGameplayEffectHandle& Handle);
+	void OnTalentEffectRemoved(const FActiveGameplayEffect& RemovedEffect);
+
+	/*
+	 * Unlock schedule. Indices of AbilitiesInformations sorted by level requirement, the ones before the cursor
+	 * have already been given, a level up only looks at the entries after it. The cursor is rewound when an ability is
+	 * removed or the level goes down, and reset when the schedule is rebuilt for another ability info.
+	 */
+	void BuildUnlockSchedule(const UAbilityInfo* AbilityInfo);
+
+	TWeakObjectPtr<const UAbilityInfo> UnlockScheduleSource;
+	TArray<int32> UnlockSchedule;
+	int32 UnlockCursor = 0;
+	int32 UnlockScheduleLevel = 0;
+
+	uint8 ActivationNotReadySlots = 0;
+	static_assert(NumInputSlots <= 8, "ActivationNotReadySlots holds one bit per input slot.");
+
+	uint16 LastProjectileVolleyId = 0;
+};
+
+/**
+ * Opens an ability update batch on the ability system component for the scope, batches can be nested.
+ */
+struct FAuraScopedAbilityUpdate
+{
+	UE_NONCOPYABLE(FAuraScopedAbilityUpdate);
+
+	explicit FAuraScopedAbilityUpdate(UAuraAbilitySystemComponent& InAbilitySystemComponent)
+		: AbilitySystemComponent(InAbilitySystemComponent)
+	{
+		AbilitySystemComponent.AbilityUpdateBatchDepth++;
+	}
+
+	~FAuraScopedAbilityUpdate()
+	{
+		if (--AbilitySystemComponent.AbilityUpdateBatchDepth == 0)
+		{
+			AbilitySystemComponent.FlushAbilityUpdates();
+		}
+	}
+
+private:
+	UAuraAbilitySystemComponent& AbilitySystemComponent;
 };
@@ -8,6 +8,7 @@
 #include "AuraAbilitySystemLibrary.generated.h"
 
 struct FDamageEffectParams;
+struct FDamageEffectTargetParams;
 struct FGameplayEffectContextHandle;
 struct FWidgetControllerParams;
 class UAbilityInfo;
@@ -165,6 +166,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
 	static void GetLivePlayersWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& SphereOrigin);
 
+	/*
+	 * Area queries below keep a live actor when the bounds of one of its overlapping components touch the shape,
+	 * like GetLivePlayersWithinRadius does with the sphere.
+	 */
+
+	// Oriented box centered on BoxCenter. HalfExtent is expressed in the local space of BoxRotation.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetLivePlayersWithinBox(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, const FVector& BoxCenter, const FRotator& BoxRotation, const FVector& HalfExtent);
+
+	// Capsule going from CapsuleStart to CapsuleEnd (segment + radius), useful for lines of fire and dashes.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetLivePlayersWithinCapsule(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, const FVector& CapsuleStart, const FVector& CapsuleEnd, float Radius);
+
+	// Forward cone (breath, beam). HalfAngle in degrees, measured from Direction.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetLivePlayersWithinCone(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, const FVector& ConeOrigin, const FVector& Direction, float Length, float HalfAngle);
+
+	// Annulus around RingOrigin (nova rings). The distance is measured on the ground plane (Z ignored), heights are
+	// only limited to OuterRadius by the broadphase sphere.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetLivePlayersWithinRing(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore, const FVector& RingOrigin, float InnerRadius, float OuterRadius);
+
+	// Single k-nearest query: up to MaxTargets live enemies of SourceActor within Radius, sorted from the closest.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetNearestLiveEnemies(const UObject* WorldContextObject, AActor* SourceActor, TArray<AActor*>& OutNearestActors, const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& Origin, int32 MaxTargets);
+
 	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
 	static void GetClosestTargets(int32 MaxTargets, const TArray<AActor*>& Actors, TArray<AActor*>& OutClosestTargets, const FVector& Origin);
 
@@ -180,6 +207,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|DamageEffect")
 	static FGameplayEffectContextHandle ApplySkillDamageEffect(const FDamageEffectParams& Params);
 
+	// Same as ApplySkillDamageEffect, with the target, death impulse and knockback taken from TargetParams instead of Params.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|DamageEffect")
+	static FGameplayEffectContextHandle ApplySkillDamageEffectToTarget(const FDamageEffectParams& Params, const FDamageEffectTargetParams& TargetParams);
+
 	UFUNCTION(BlueprintPure, Category="AuraAbilitySystemLibrary|GameplayMechanics")
 	static TArray<FRotator> EvenlySpaceRotators(const FVector& Forward, const FVector& Axis, float Spread, int32 NumRotators);
 
@@ -203,6 +234,10 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|DamageEffectParams")
 	static void SetEffectParamsTargetASC(UPARAM(ref) FDamageEffectParams& DamageEffectParams, UAbilitySystemComponent* InASC);
+
+	// Death impulse along HitDirection, and knockback if the knockback chance of the params succeeds.
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|DamageEffectParams")
+	static FDamageEffectTargetParams MakeDamageEffectTargetParams(const FDamageEffectParams& DamageEffectParams, UAbilitySystemComponent* InASC, FVector HitDirection);
 };
 
 
@@ -0,0 +1,40 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAuraSpreadPattern : uint8
+{
+	// Count directions evenly spread over Spread degrees around the axis, first one on the left.
+	Fan,
+	// Count directions evenly spread all around the axis, Spread is ignored.
+	Ring,
+	// Count directions filling a cone of Spread degrees along a golden angle spiral.
+	Spiral,
+	// Count random directions inside a cone of Spread degrees, picked by the seed.
+	RandomCone
+};
+
+using FAuraSpreadDirections = TArray<FVector, TInlineAllocator<16>>;
+
+/**
+ * AuraSpreadPatterns
+ *
+ * Directions of multi projectile skills. The pattern is computed once per (pattern, spread, count) in a local frame
+ * and cached, building the directions of a cast is then only a change of frame. The cache is emptied when it reaches
+ * Aura.SpreadPatterns.MaxCached entries.
+ * Game thread only.
+ */
+struct AURA_API FAuraSpreadPatterns
+{
+	static void BuildDirections(EAuraSpreadPattern Pattern, const FVector& Forward, const FVector& Axis, float Spread, int32 Count, FAuraSpreadDirections& OutDirections, int32 Seed = 0);
+
+	static void ClearCache();
+
+private:
+	static const TArray<FVector3f>& GetLocalPattern(EAuraSpreadPattern Pattern, float Spread, int32 Count);
+	static void ComputeLocalPattern(EAuraSpreadPattern Pattern, float Spread, int32 Count, TArray<FVector3f>& OutPattern);
+
+	static TMap<uint64, TArray<FVector3f>> PatternCache;
+};
@@ -22,10 +22,16 @@ public:
 	void SpawnProjectiles(const FVector& ProjectileTargetLocation, const FGameplayTag& SocketTag, bool bOverridePitch, float PitchOverride, AActor* HomingTarget);
 
 protected:
+	// Gives each bolt of the volley its own live enemy around the aim point, nullptr entries fall back to spread points.
+	void DistributeHomingTargets(const FVector& AimLocation, AActor* HomingTarget, TArray<AActor*>& OutBoltTargets) const;
 
 	UPROPERTY(EditDefaultsOnly, Category = "FireBolt")
 	float ProjectileSpread = 90.f;
 
+	// Radius around the aim point in which the volley looks for additional homing targets.
+	UPROPERTY(EditDefaultsOnly, Category = "FireBolt")
+	float HomingTargetSearchRadius = 600.f;
+
 	UPROPERTY(EditDefaultsOnly, Category = "FireBolt")
 	float HomingAccelerationMin = 1600.f;
 
@@ -34,4 +40,9 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "FireBolt")
 	bool bLauncHomingProjectiles = true;
+
+	// Bolts are not replicated, clients rebuild them from a single volley multicast and only the server hits count.
+	// Each server impact is sent as a bolt index, so the client bolt stops there. Needs an AAuraPooledProjectile class.
+	UPROPERTY(EditDefaultsOnly, Category = "FireBolt")
+	bool bUseVolleyReplication = true;
 };
@@ -20,8 +20,14 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void StoreMouseDataInfo(const FHitResult& HitResult);
 
+	// Traced through USkillBeamTraceSubsystem, toward BeamTargetLocation during this frame. Calls with the same target
+	// in the same frame reuse the trace.
 	UFUNCTION(BlueprintCallable)
 	void TraceFirstTarget(const FVector& BeamTargetLocation);
+
+	// Last trace of the beam, the one of the last TraceFirstTarget. The beam slot is not refreshed by the subsystem tick.
+	UFUNCTION(BlueprintPure, Category = "Beam")
+	bool GetBeamTraceResult(FHitResult& OutHitResult) const;
 	
 	UFUNCTION(BlueprintCallable)
 	AActor* FindNextTarget(const FVector& PreviousTargetLocation);
@@ -34,6 +40,7 @@ public:
 	int32 GetMaxNumChainTargets();
 	
 protected:
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 
 	UPROPERTY(BlueprintReadWrite, Category = "Beam")
 	FVector MouseHitLocation;
@@ -47,6 +54,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Beam")
 	float BeamChainRadius = 300.f;
 
+	UPROPERTY(EditDefaultsOnly, Category = "Beam")
+	FName BeamSocketName = FName("TipSocket");
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Beam")
 	int32 MaxNumChainTargets = 3;
+
+private:
+	// Slot in USkillBeamTraceSubsystem, registered on the first trace and released when the ability ends.
+	int32 BeamTraceSlot = INDEX_NONE;
 };
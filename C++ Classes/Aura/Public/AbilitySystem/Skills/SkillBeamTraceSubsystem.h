@@ -0,0 +1,66 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SkillBeamTraceSubsystem.generated.h"
+
+class USkeletalMeshSocket;
+
+/**
+ * One traced beam. Everything that does not change while the beam is held (ignore set, socket, radius)
+ * is built once at registration.
+ */
+struct FSkillBeamTraceSlot
+{
+	TWeakObjectPtr<const UObject> Owner;
+	TWeakObjectPtr<USkeletalMeshComponent> Weapon;
+	TWeakObjectPtr<const USkeletalMeshSocket> Socket;
+	FName SocketName = NAME_None;
+	FCollisionQueryParams QueryParams;
+	float Radius = 0.f;
+	FVector TargetLocation = FVector::ZeroVector;
+	bool bHasTarget = false;
+	FHitResult HitResult;
+	bool bHasResult = false;
+	// Also traced in Tick when its owner did not trace it during the frame.
+	bool bAutoRefresh = false;
+	// GFrameCounter of the last trace, a slot is traced at most once per frame and target.
+	uint64 LastTraceFrame = 0;
+};
+
+/**
+ * Keeps the traces of every held beam of the world, with the query data of each beam built once.
+ * Abilities register a slot when the beam starts and trace it with TraceBeam, which traces right away unless the slot was
+ * already traced this frame toward the same target. Only the slots registered with bAutoRefresh are also traced in Tick
+ * when their ability did not trace them during the frame, so GetBeamResult follows the caster when the target does not move.
+ */
+UCLASS()
+class AURA_API USkillBeamTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	int32 RegisterBeam(const UObject* Owner, USkeletalMeshComponent* Weapon, FName SocketName, float Radius, const AActor* IgnoredActor, bool bAutoRefresh = false);
+	void UnregisterBeam(int32 SlotIndex);
+
+	void AddIgnoredActor(int32 SlotIndex, const AActor* Actor);
+
+	// Result of the slot traced toward TargetLocation during this frame, nullptr if the slot is not valid.
+	const FHitResult* TraceBeam(int32 SlotIndex, const FVector& TargetLocation);
+
+	// Last blocking or non-blocking result of the slot, nullptr if it has not been traced yet. It is the one of the last
+	// TraceBeam, or of the last tick for an auto refreshed slot. Use TraceBeam for a current result.
+	const FHitResult* GetBeamResult(int32 SlotIndex) const;
+
+private:
+	bool IsValidSlot(int32 SlotIndex) const;
+	void TraceSlot(const UWorld* World, FSkillBeamTraceSlot& Slot) const;
+
+	TSparseArray<FSkillBeamTraceSlot> BeamSlots;
+	int32 NumAutoRefreshSlots = 0;
+};
@@ -23,6 +23,14 @@ public:
 	
 	float GetTalentsModifiersForAttribute(float OutValue, const FGameplayTag& AttributeTag);
 
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+
+	// Damage params of the current activation, built with MakeDamageEffectParamsFromClassDefaults on first use.
+	// Abilities casting several times in one activation call ResetCastDamageEffectParams between casts.
+	FSharedDamageEffectParams GetCastDamageEffectParams();
+	void ResetCastDamageEffectParams() { CastDamageEffectParams.Reset(); }
+
 	virtual FDamageEffectParams MakeDamageEffectParamsFromClassDefaults(
 		AActor* TargetActor = nullptr,
 		FVector InRadialDamageOrigin = FVector::ZeroVector,
@@ -52,4 +60,7 @@ public:
 protected:
 	bool bTalentTreeSetup = false;
 
+private:
+	FSharedDamageEffectParams CastDamageEffectParams;
+
 };
@@ -6,6 +6,7 @@
 
 class UGameplayEffect;
 class AAuraProjectile;
+struct FAuraProjectileSpawnRequest;
 
 UCLASS()
 class USkillDamageProjectile : public USkillDamageGameplayAbility
@@ -14,10 +15,15 @@ class USkillDamageProjectile : public USkillDamageGameplayAbility
 	
 protected:
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 
 	UFUNCTION(BlueprintCallable, Category = "Projectile")
 	virtual void SpawnProjectile(const FVector& ProjectileTargetLocation, const FGameplayTag& SocketTag, bool bOverridePitch = false, float PitchOverride = 0.f);
+
+	// Request for a projectile of this skill, to be given to UAuraProjectileSpawnSubsystem.
+	FAuraProjectileSpawnRequest MakeProjectileSpawnRequest(const FTransform& SpawnTransform);
 	
+	// Pooled when it is an AAuraPooledProjectile.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TSubclassOf<AAuraProjectile> ProjectileClass;
 
@@ -26,5 +32,14 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Projectile")
 	int32 MaxNumProjectiles = 5;
+
+	// Projectiles spawned in UAuraProjectilePoolSubsystem when the ability is given.
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+	int32 ProjectilePoolPrewarmCount = 10;
+
+	// Server projectiles are moved by UAuraProjectileSimulationSubsystem instead of ticking their own ProjectileMovement.
+	// Opt-in: the batch sweeps one segment per frame, enable it for fast straight or homing bolts in large volleys.
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+	bool bSimulateProjectilesInBatch = false;
 	
 };
@@ -0,0 +1,50 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuraAbilityTypes.h"
+#include "Actor/AuraProjectile.h"
+#include "Interaction/PoolableInterface.h"
+#include "AuraPooledProjectile.generated.h"
+
+/**
+ * Projectile recycled by UAuraProjectilePoolSubsystem: on impact and when its life span expires it goes back to the pool
+ * instead of being destroyed. Skill projectiles are parented to it to be pooled.
+ */
+UCLASS()
+class AURA_API AAuraPooledProjectile : public AAuraProjectile, public IPoolableInterface
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void LifeSpanExpired() override;
+
+	/* Poolable Interface */
+	virtual void OnAcquiredFromPool_Implementation() override;
+	virtual void OnReleasedToPool_Implementation() override;
+	/* End Poolable Interface */
+
+	// Damage of the cast, shared by all its projectiles instead of copied in DamageEffectParams.
+	// Only the part depending on the hit target is built on impact. Unset on cosmetic projectiles, which ignore overlaps.
+	FSharedDamageEffectParams SharedDamageEffectParams;
+
+	// Bolt of a replicated volley. The server bolt notifies its impact to clients, which stop their bolt with StopAt.
+	uint16 VolleyId = 0;
+	uint8 BoltIndex = 0;
+	void StopAt(const FVector& ImpactLocation);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void OnHit() override;
+	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
+
+private:
+	// Replicated so clients also reset the hit state and the looping sound of a reused projectile.
+	UPROPERTY(ReplicatedUsing=OnRep_InPool)
+	bool bInPool = false;
+
+	UFUNCTION()
+	void OnRep_InPool();
+};
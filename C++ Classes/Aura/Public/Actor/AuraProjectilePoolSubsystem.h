@@ -0,0 +1,86 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraProjectilePoolSubsystem.generated.h"
+
+class AAuraProjectile;
+
+USTRUCT()
+struct FAuraProjectilePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraProjectile>> InactiveProjectiles;
+
+	// Projectiles that don't replicate, rebuilt locally from a volley. Never reused as replicated ones.
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraProjectile>> InactiveCosmeticProjectiles;
+
+	TArray<TObjectPtr<AAuraProjectile>>& GetInactiveProjectiles(bool bReplicates)
+	{
+		return bReplicates ? InactiveProjectiles : InactiveCosmeticProjectiles;
+	}
+
+	// Life span given to the projectile by its own BeginPlay, restored every time it leaves the pool.
+	float LifeSpan = 0.f;
+};
+
+/**
+ * Pool of skill projectiles, one pool per projectile class, with replicated and cosmetic projectiles kept apart.
+ * Pooled projectiles are hidden, without collision nor movement, and the replicated ones are dormant so they cost
+ * nothing to replication.
+ * Only classes implementing IPoolableInterface are pooled, they are the ones calling ReleaseProjectile instead of
+ * Destroy(). The others are spawned and destroyed as before, and never prewarmed.
+ */
+UCLASS()
+class AURA_API UAuraProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Spawns hidden and dormant projectiles up to Count, for poolable classes only.
+	void PrewarmPool(TSubclassOf<AAuraProjectile> ProjectileClass, int32 Count);
+
+	static bool IsPoolable(TSubclassOf<AAuraProjectile> ProjectileClass);
+
+	/**
+	 * Returns a projectile ready to be configured (DamageEffectParams, homing...). It is either a pooled projectile
+	 * reset to its class defaults, or a new deferred spawn. FinishAcquireProjectile must be called once configured.
+	 */
+	AAuraProjectile* AcquireProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, bool bReplicates = true);
+	void FinishAcquireProjectile(AAuraProjectile* Projectile, const FTransform& SpawnTransform);
+
+	/**
+	 * Scene component used as homing target when a projectile homes to a location rather than an actor.
+	 * Anchors are owned by the subsystem and go back to a free list when the projectile is released or destroyed,
+	 * so homing volleys don't allocate whether their projectiles are pooled or not.
+	 */
+	USceneComponent* AcquireHomingAnchor(AAuraProjectile* Projectile, const FVector& TargetLocation);
+
+	// To be used by poolable projectiles instead of Destroy(), on impact and when their life span expires.
+	// Falls back to Destroy() if the projectile can't go back to a pool.
+	static void ReleaseProjectile(AAuraProjectile* Projectile);
+
+private:
+	AAuraProjectile* SpawnPooledProjectile(TSubclassOf<AAuraProjectile> ProjectileClass);
+	bool ReturnToPool(AAuraProjectile* Projectile);
+	void DeactivateProjectile(AAuraProjectile* Projectile) const;
+	void ReleaseHomingAnchor(const AAuraProjectile* Projectile);
+	static void ResetProjectileState(AAuraProjectile* Projectile);
+
+	UFUNCTION()
+	void OnPooledProjectileDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY()
+	TMap<TSubclassOf<AAuraProjectile>, FAuraProjectilePool> Pools;
+
+	UPROPERTY()
+	TMap<TObjectPtr<AAuraProjectile>, TObjectPtr<USceneComponent>> HomingAnchors;
+
+	UPROPERTY()
+	TArray<TObjectPtr<USceneComponent>> FreeHomingAnchors;
+};
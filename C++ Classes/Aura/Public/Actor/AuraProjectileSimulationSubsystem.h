@@ -0,0 +1,59 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraProjectileSimulationSubsystem.generated.h"
+
+class AAuraProjectile;
+
+/**
+ * Server side simulation of skill projectiles, replacing the tick of their ProjectileMovementComponent.
+ * The state of every projectile is kept in parallel arrays, integrated in batches over the task graph with the sub-steps
+ * of the movement component, then the actors are only moved (swept, so their overlaps still fire) in a single pass on
+ * the game thread. The sweep is one segment per frame.
+ * A blocking hit bounces the projectile like its movement component would, or stops it through
+ * UProjectileMovementComponent::StopSimulating and hands it back. Life span is left to the actor.
+ */
+UCLASS()
+class AURA_API UAuraProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Takes over a spawned projectile: its movement settings are copied and its movement tick is disabled.
+	// HomingLocation is homed to when the projectile is homing without a target component, no anchor is needed.
+	void AddProjectile(AAuraProjectile* Projectile, const TOptional<FVector>& HomingLocation = TOptional<FVector>());
+
+	// Called when the projectile goes back to the pool. The entry is compacted on the next tick.
+	void RemoveProjectile(const AAuraProjectile* Projectile);
+
+	int32 Num() const { return Proxies.Num(); }
+
+private:
+	void IntegrateBatch(int32 Begin, int32 End, float DeltaTime);
+	void HandleBlockingHit(int32 Index, const FHitResult& Hit);
+	void RemoveAtSwap(int32 Index);
+
+	// One entry per projectile, all arrays share the same index.
+	TArray<TWeakObjectPtr<AAuraProjectile>> Proxies;
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<TWeakObjectPtr<USceneComponent>> HomingTargets;
+	TArray<FVector> HomingLocations;
+	// 1 when HomingLocations is a fixed location given at AddProjectile.
+	TArray<uint8> HomesToLocation;
+	// 1 while the homing target is valid, 0 otherwise, so the integration has no branch on it.
+	TArray<float> HomingMasks;
+	TArray<float> HomingAccelerations;
+	TArray<float> GravityZ;
+	TArray<float> MaxSpeeds;
+	// 0 when the movement component would not sub-step.
+	TArray<float> MaxTimeSteps;
+	TArray<int32> MaxIterations;
+	TArray<uint8> RotationFollowsVelocity;
+};
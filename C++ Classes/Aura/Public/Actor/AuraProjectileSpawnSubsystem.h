@@ -0,0 +1,86 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuraAbilityTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AuraProjectileSpawnSubsystem.generated.h"
+
+class AAuraProjectile;
+
+/**
+ * Everything needed to spawn a skill projectile later than the frame it was requested in.
+ */
+struct FAuraProjectileSpawnRequest
+{
+	TSubclassOf<AAuraProjectile> ProjectileClass;
+	FTransform SpawnTransform;
+	TWeakObjectPtr<AActor> Owner;
+	TWeakObjectPtr<APawn> Instigator;
+	FSharedDamageEffectParams DamageEffectParams;
+
+	// Homing settings are only applied when bOverrideHoming is set, otherwise the class defaults are kept.
+	bool bOverrideHoming = false;
+	bool bIsHomingProjectile = false;
+	float HomingAccelerationMagnitude = 0.f;
+	// Homed to when valid, HomingTargetLocation is used otherwise.
+	TWeakObjectPtr<USceneComponent> HomingTargetComponent;
+	FVector HomingTargetLocation = FVector::ZeroVector;
+
+	bool bSimulateInBatch = false;
+	bool bReplicates = true;
+
+	// Set for the bolts of a replicated volley, so the server impacts reach the matching client bolts.
+	uint16 VolleyId = 0;
+	uint8 BoltIndex = 0;
+
+	// Time the projectile should already have flown when it is spawned.
+	float LaunchDelay = 0.f;
+
+	// Set by the subsystem, used to move late projectiles to where they would be if spawned on time.
+	double RequestTime = 0.0;
+};
+
+/**
+ * Spawns skill projectiles under a per frame budget (Aura.ProjectileSpawn.MaxPerFrame and Aura.ProjectileSpawn.BudgetMs).
+ * Requests within the budget are spawned right away, the others are queued and spawned on the next frames,
+ * advanced along their direction by the time they waited.
+ */
+UCLASS()
+class AURA_API UAuraProjectileSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RequestSpawn(FAuraProjectileSpawnRequest&& Request);
+
+	// Requests every bolt of the volley, Template gives what is common to them (class, owner, damage params...).
+	void SpawnVolley(const FAuraProjectileVolley& Volley, const FAuraProjectileSpawnRequest& Template);
+
+	int32 GetNumPendingRequests() const { return PendingRequests.Num(); }
+
+	// Client side, stops the cosmetic bolt rebuilt for this bolt of a volley of Owner. A bolt not spawned yet is skipped.
+	void StopVolleyBolt(const AActor* Owner, uint16 VolleyId, uint8 BoltIndex, const FVector& ImpactLocation);
+
+private:
+	void DrainPendingRequests();
+	void SpawnProjectile(const FAuraProjectileSpawnRequest& Request, double Now);
+
+	TArray<FAuraProjectileSpawnRequest> PendingRequests;
+
+	// Cosmetic bolts of replicated volleys, by owner and (volley id, bolt index).
+	using FVolleyBoltKey = TPair<FObjectKey, uint32>;
+	static uint32 MakeVolleyBoltId(uint16 VolleyId, uint8 BoltIndex) { return static_cast<uint32>(VolleyId) << 8 | BoltIndex; }
+	TMap<FVolleyBoltKey, TWeakObjectPtr<AAuraProjectile>> VolleyBolts;
+	// Impacts received before their bolt was spawned.
+	TSet<FVolleyBoltKey> StoppedVolleyBolts;
+
+	uint64 BudgetFrame = 0;
+	int32 SpawnedThisFrame = 0;
+	double SecondsSpentThisFrame = 0.0;
+};
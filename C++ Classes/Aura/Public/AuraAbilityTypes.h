@@ -5,6 +5,7 @@
 #include "AuraAbilityTypes.generated.h"
 
 class UGameplayEffect;
+class AAuraProjectile;
 
 USTRUCT(BlueprintType)
 struct FDamageEffectParams
@@ -87,25 +88,108 @@ struct FDamageEffectParams
 	FGameplayTag SkillTag = FGameplayTag();
 };
 
+// Built once per cast and shared, read only, by everything the cast spawns.
+using FSharedDamageEffectParams = TSharedPtr<const FDamageEffectParams>;
+
+/**
+ * Part of a damage application that depends on the hit target, applied on top of shared FDamageEffectParams.
+ */
+USTRUCT(BlueprintType)
+struct FDamageEffectTargetParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	TObjectPtr<UAbilitySystemComponent> TargetAbilitySystemComponent = nullptr;
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector DeathImpulse = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector KnockbackForce = FVector::ZeroVector;
+};
+
+/**
+ * Everything a client needs to rebuild the bolts of a projectile volley locally.
+ * Bolt directions come from the fan of FAuraSpreadPatterns and homing accelerations from a random stream seeded with Seed,
+ * so server and clients get the same bolts without replicating them one by one.
+ */
+USTRUCT()
+struct FAuraProjectileVolley
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AAuraProjectile> ProjectileClass = nullptr;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Forward = FVector::ForwardVector;
+
+	UPROPERTY()
+	float Spread = 0.f;
+
+	UPROPERTY()
+	uint8 NumProjectiles = 0;
+
+	// Distance of the spread points homed to by the bolts without a target.
+	UPROPERTY()
+	float AimDistance = 0.f;
+
+	UPROPERTY()
+	bool bIsHoming = false;
+
+	UPROPERTY()
+	float HomingAccelerationMin = 0.f;
+
+	UPROPERTY()
+	float HomingAccelerationMax = 0.f;
+
+	UPROPERTY()
+	int32 Seed = 0;
+
+	// Homing target of each bolt, may be shorter than NumProjectiles or hold null entries.
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Targets;
+
+	// Server world time of the launch, lets clients catch up with the server bolts.
+	UPROPERTY()
+	float ServerTime = 0.f;
+
+	// Identifies the volley in the impact notifications of its bolts, never 0.
+	UPROPERTY()
+	uint16 VolleyId = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FAuraGameplayEffectContext : public FGameplayEffectContext
 {
 	GENERATED_BODY()
 public:
+	FAuraGameplayEffectContext()
+		: bIsBlockedHit(false)
+		, bIsCriticalHit(false)
+		, bIsSuccessfulDebuff(false)
+		, bIsRadialDamage(false)
+	{
+	}
+
 	bool IsBlockedHit() const { return bIsBlockedHit; }
 	bool IsCriticalHit() const { return bIsCriticalHit; }
 	bool IsSuccessfulDebuff() const { return bIsSuccessfulDebuff; }
 	float GetDebuffDamage() const { return DebuffDamage; }
 	float GetDebuffDuration() const { return DebuffDuration; }
 	float GetDebuffFrequency() const { return DebuffFrequency; }
-	TSharedPtr<FGameplayTag> GetDamageType() const { return DamageType; }
+	const FGameplayTag& GetDamageType() const { return DamageType; }
 	FVector GetDeathImpulse() const { return DeathImpulse; }
 	FVector GetKnockbackForce() const { return KnockbackForce; }
 	bool IsRadialDamage() const { return bIsRadialDamage; }
 	float GetRadialDamageInnerRadius() const { return RadialDamageInnerRadius; }
 	float GetRadialDamageOuterRadius() const { return RadialDamageOuterRadius; }
 	FVector GetRadialDamageOrigin() const { return RadialDamageOrigin; }
-	TSharedPtr<FGameplayTag> GetSkillTag() const { return SkillTag; }
+	const FGameplayTag& GetSkillTag() const { return SkillTag; }
 
 
 	void SetIsBlockedHit(bool bInIsBlockedHit) { bIsBlockedHit = bInIsBlockedHit; }
@@ -114,14 +198,14 @@ public:
 	void SetDebuffDamage(float InDebuffDamage) { DebuffDamage = InDebuffDamage; }
 	void SetDebuffDuration(float InDebuffDuration) { DebuffDuration = InDebuffDuration; }
 	void SetDebuffFrequency(float InDebuffFrequency) { DebuffFrequency = InDebuffFrequency; }
-	void SetDamageType(TSharedPtr<FGameplayTag> InDamageType) { DamageType = InDamageType; }
+	void SetDamageType(const FGameplayTag& InDamageType) { DamageType = InDamageType; }
 	void SetDeathImpulse(FVector InDeathImpulse) { DeathImpulse = InDeathImpulse; }
 	void SetKnockbackForce(FVector InKnockbackForce) { KnockbackForce = InKnockbackForce; }
 	void SetIsRadialDamage(bool bInIsRadialDamage) { bIsRadialDamage = bInIsRadialDamage; }
 	void SetRadialDamageInnerRadius(float InRadialDamageInnerRadius) { RadialDamageInnerRadius = InRadialDamageInnerRadius; }
 	void SetRadialDamageOuterRadius(float InRadialDamageOuterRadius) { RadialDamageOuterRadius = InRadialDamageOuterRadius; }
 	void SetRadialDamageOrigin(FVector InRadialDamageOrigin) { RadialDamageOrigin = InRadialDamageOrigin; }
-	void SetSkillTag(TSharedPtr<FGameplayTag> InSkillTag) { SkillTag = InSkillTag; }
+	void SetSkillTag(const FGameplayTag& InSkillTag) { SkillTag = InSkillTag; }
 
 	/** Returns the actual struct used for serialization, subclasses must override this! */
 	virtual UScriptStruct* GetScriptStruct() const
@@ -144,18 +228,27 @@ public:
 
 	/** Custom serialization, subclasses must override this */
 	virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
-	
-protected:
 
-	UPROPERTY()
-	bool bIsBlockedHit = false;
+private:
+	/**
+	 * One replicated field: when it is sent, how it is written and read, and what it becomes when it is not sent
+	 * (nullptr keeps the current value). Each field of GetNetSchema gets one rep bit, in the schema order.
+	 * Flags are carried by their rep bit alone. Name is what the net profiler reports the field as.
+	 */
+	struct FNetField
+	{
+		const TCHAR* Name;
+		bool (*ShouldSerialize)(const FAuraGameplayEffectContext& Context);
+		void (*Serialize)(FAuraGameplayEffectContext& Context, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+		void (*Reset)(FAuraGameplayEffectContext& Context);
+	};
+	static TConstArrayView<FNetField> GetNetSchema();
+	// Sizes of the fields in RepBits, measured again for the net profiler.
+	void RecordNetProfile(uint32 RepBits);
 	
-	UPROPERTY()
-	bool bIsCriticalHit = false;
+protected:
+	// Values first and flags packed at the end, tags are stored inline so a context never allocates beside itself.
 
-	UPROPERTY()
-	bool bIsSuccessfulDebuff = false;
-	
 	UPROPERTY()
 	float DebuffDamage = 0.f;
 
@@ -165,9 +258,11 @@ protected:
 	UPROPERTY()
 	float DebuffFrequency = 0.f;
 
-	// No UPROPERTY because garbage collection is not handled for TSharedPtr by UPROPERTY.
-	// TSharedPtr (and other associated smart pointers) handles the automatic memory management.
-	TSharedPtr<FGameplayTag> DamageType;
+	UPROPERTY()
+	float RadialDamageInnerRadius = 0.f;
+
+	UPROPERTY()
+	float RadialDamageOuterRadius = 0.f;
 
 	UPROPERTY()
 	FVector DeathImpulse = FVector::ZeroVector;
@@ -176,19 +271,25 @@ protected:
 	FVector KnockbackForce = FVector::ZeroVector;
 
 	UPROPERTY()
-	bool bIsRadialDamage = false;
+	FVector RadialDamageOrigin = FVector::ZeroVector;
 
 	UPROPERTY()
-	float RadialDamageInnerRadius = 0.f;
+	FGameplayTag DamageType = FGameplayTag();
 
 	UPROPERTY()
-	float RadialDamageOuterRadius = 0.f;
+	FGameplayTag SkillTag = FGameplayTag();
 
 	UPROPERTY()
-	FVector RadialDamageOrigin = FVector::ZeroVector;
+	uint8 bIsBlockedHit : 1;
+	
+	UPROPERTY()
+	uint8 bIsCriticalHit : 1;
 
-	TSharedPtr<FGameplayTag> SkillTag;
+	UPROPERTY()
+	uint8 bIsSuccessfulDebuff : 1;
 
+	UPROPERTY()
+	uint8 bIsRadialDamage : 1;
 };
 
 template<>
@@ -4,6 +4,143 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "NativeGameplayTags.h"
+
+/**
+ * Every native Gameplay Tag of the game, as X(Name, Tag, Comment). Adding a tag here declares its static native tag,
+ * its EAuraGameplayTag index and its FAuraGameplayTags member.
+ */
+#define AURA_GAMEPLAY_TAGS(X) \
+	X(Attributes_Primary_Strength, "Attributes.Primary.Strength", "Increase Physical Damage") \
+	X(Attributes_Primary_Intelligence, "Attributes.Primary.Intelligence", "Increase Magical Damage") \
+	X(Attributes_Primary_Resilience, "Attributes.Primary.Resilience", "Increase Armor and Armor Penetration") \
+	X(Attributes_Primary_Vigor, "Attributes.Primary.Vigor", "Increase Health") \
+	\
+	X(Attributes_Secondary_Armor, "Attributes.Secondary.Armor", "Reduces damage taken, improves Block Chance") \
+	X(Attributes_Secondary_ArmorPenetration, "Attributes.Secondary.ArmorPenetration", "Ignore Percentage pf enemy Armor, increase Critical hit Chance") \
+	X(Attributes_Secondary_BlockChance, "Attributes.Secondary.BlockChance", "Chance to cut incoming damage in half") \
+	X(Attributes_Secondary_CriticalHitChance, "Attributes.Secondary.CriticalHitChance", "Chance to double damage plus critical hit bonus") \
+	X(Attributes_Secondary_CriticalHitDamage, "Attributes.Secondary.CriticalHitDamage", "Bonus damage added when a critical hit is scored") \
+	X(Attributes_Secondary_CriticalHitResistance, "Attributes.Secondary.CriticalHitResistance", "Reduce Critical Hit Chance of attacking enemies") \
+	X(Attributes_Secondary_HealthRegeneration, "Attributes.Secondary.HealthRegeneration", "Amount of Health regenerated every 1 second") \
+	X(Attributes_Secondary_ManaRegeneration, "Attributes.Secondary.ManaRegeneration", "Amount of Mana regenerated every 1 second") \
+	X(Attributes_Secondary_MaxHealth, "Attributes.Secondary.MaxHealth", "Maximum amount of Health obtainable") \
+	X(Attributes_Secondary_MaxMana, "Attributes.Secondary.MaxMana", "Maximum amount of Mana obtainable") \
+	X(Attributes_Secondary_Health, "Attributes.Secondary.Health", "Current Amount of Health") \
+	X(Attributes_Secondary_Mana, "Attributes.Secondary.Mana", "Current Amount of Mana") \
+	\
+	X(Attributes_Meta_IncomingXP, "Attributes.Meta.IncomingXP", "Experience received") \
+	\
+	X(InputTag_LMB, "InputTag.LMB", "Input Tag for Left Mouse Button") \
+	X(InputTag_RMB, "InputTag.RMB", "Input Tag for Right Mouse Button") \
+	X(InputTag_1, "InputTag.1", "Input Tag for 1 key") \
+	X(InputTag_2, "InputTag.2", "Input Tag for 2 key") \
+	X(InputTag_3, "InputTag.3", "Input Tag for 3 key") \
+	X(InputTag_4, "InputTag.4", "Input Tag for 4 key") \
+	X(InputTag_Passive_1, "InputTag.Passive.1", "Input Tag for Passive 1") \
+	X(InputTag_Passive_2, "InputTag.Passive.2", "Input Tag for Passive 2") \
+	\
+	X(Damage, "Damage", "Damage") \
+	X(Damage_Fire, "Damage.Fire", "Fire Damage Type") \
+	X(Damage_Lightning, "Damage.Lightning", "Lightning Damage Type") \
+	X(Damage_Arcane, "Damage.Arcane", "Arcane Damage Type") \
+	X(Damage_Physical, "Damage.Physical", "Physical Damage Type") \
+	\
+	X(Attributes_Resistance_Fire, "Attributes.Resistance.Fire", "Fire Resistance") \
+	X(Attributes_Resistance_Lightning, "Attributes.Resistance.Lightning", "Lightning Resistance") \
+	X(Attributes_Resistance_Arcane, "Attributes.Resistance.Arcane", "Arcane Resistance") \
+	X(Attributes_Resistance_Physical, "Attributes.Resistance.Physical", "Physical Resistance") \
+	\
+	X(Debuff_Burn, "Debuff.Burn", "Debuff for Fire Damage") \
+	X(Debuff_Stun, "Debuff.Stun", "Debuff for Lightning Damage") \
+	X(Debuff_Arcane, "Debuff.Arcane", "Debuff for Arcane Damage") \
+	X(Debuff_Physical, "Debuff.Physical", "Debuff for Physical Damage") \
+	\
+	X(Debuff_Chance, "Debuff.Chance", "Debuff Chance") \
+	X(Debuff_Damage, "Debuff.Damage", "Debuff Damage") \
+	X(Debuff_Frequency, "Debuff.Frequency", "Debuff Frequency") \
+	X(Debuff_Duration, "Debuff.Duration", "Debuff Duration") \
+	\
+	X(Abilities_None, "Abilities.None", "No Ability - like the nullptr for Ability Tags") \
+	X(Abilities_Attack, "Abilities.Attack", "Attack Ability Tag") \
+	X(Abilities_Summon, "Abilities.Summon", "Summon Ability Tag") \
+	X(Abilities_HitReact, "Abilities.HitReact", "HitReact Ability Tag") \
+	\
+	X(Abilities_Status_Locked, "Abilities.Status.Locked", "Locked Status Ability Tag") \
+	X(Abilities_Status_Eligible, "Abilities.Status.Eligible", "Eligible Status Ability Tag") \
+	X(Abilities_Status_Unlocked, "Abilities.Status.Unlocked", "Unlocked Status Ability Tag") \
+	X(Abilities_Status_Equipped, "Abilities.Status.Equipped", "Equipped Status Ability Tag") \
+	\
+	X(Abilities_Type_Offensive, "Abilities.Type.Offensive", "Type Offensive Ability Tag") \
+	X(Abilities_Type_Passive, "Abilities.Type.Passive", "Type Passive Ability Tag") \
+	X(Abilities_Type_None, "Abilities.Type.None", "Type None Ability Tag") \
+	\
+	X(Abilities_Fire_Firebolt, "Abilities.Fire.Firebolt", "Firebolt Ability Tag") \
+	X(Cooldown_Fire_Firebolt, "Cooldown.Fire.Firebolt", "Firebolt Cooldown Tag") \
+	\
+	X(Abilities_Fire_FireBlast, "Abilities.Fire.FireBlast", "FireBlast Ability Tag") \
+	X(Cooldown_Fire_FireBlast, "Cooldown.Fire.FireBlast", "FireBlast Cooldown Tag") \
+	\
+	X(Abilities_Lightning_Electrocute, "Abilities.Lightning.Electrocute", "Electrocute Ability Tag") \
+	X(Cooldown_Lightning_Electrocute, "Cooldown.Lightning.Electrocute", "Electrocute Cooldown Tag") \
+	\
+	X(Abilities_Lightning_LightningChain, "Abilities.Lightning.LightningChain", "LightningChain Ability Tag") \
+	X(Cooldown_Lightning_LightningChain, "Cooldown.Lightning.LightningChain", "LightningChain Cooldown Tag") \
+	\
+	X(Abilities_Arcane_ArcaneShards, "Abilities.Arcane.ArcaneShards", "ArcaneShards Ability Tag") \
+	X(Cooldown_Arcane_ArcaneShards, "Cooldown.Arcane.ArcaneShards", "ArcaneShards Cooldown Tag") \
+	\
+	X(Abilities_Fire_MeteorShower, "Abilities.Fire.MeteorShower", "Meteor Shower Ability Tag") \
+	X(Cooldown_Fire_MeteorShower, "Cooldown.Fire.MeteorShower", "Meteor Shower Ability Tag") \
+	\
+	X(Abilities_Passive_HaloOfProtection, "Abilities.Passive.HaloOfProtection", "Passive Ability Halo of Protection") \
+	X(Abilities_Passive_LifeSiphon, "Abilities.Passive.LifeSiphon", "Passive Ability Life Siphon") \
+	X(Abilities_Passive_ManaSiphon, "Abilities.Passive.ManaSiphon", "Passive Ability Mana siphon") \
+	\
+	X(CombatSocket_Weapon, "CombatSocket.Weapon", "Weapon") \
+	X(CombatSocket_RightHand, "CombatSocket.RightHand", "RightHand") \
+	X(CombatSocket_LeftHand, "CombatSocket.LeftHand", "LeftHand") \
+	X(CombatSocket_Tail, "CombatSocket.Tail", "Tail") \
+	\
+	X(Montage_Attack_1, "Montage.Attack.1", "Attack 1") \
+	X(Montage_Attack_2, "Montage.Attack.2", "Attack 2") \
+	X(Montage_Attack_3, "Montage.Attack.3", "Attack 3") \
+	X(Montage_Attack_4, "Montage.Attack.4", "Attack 4") \
+	\
+	X(Effects_HitReact, "Effects.HitReact", "Tag granted when Hit Reacting") \
+	\
+	X(Player_Block_InputPressed, "Player.Block.InputPressed", "Block InputPressed callback for input") \
+	X(Player_Block_InputHeld, "Player.Block.InputHeld", "Block Input Held callback for input") \
+	X(Player_Block_InputReleased, "Player.Block.InputReleased", "Block InputReleased callback for input") \
+	X(Player_Block_CursorTrace, "Player.Block.CursorTrace", "Block tracing under the cursor") \
+	\
+	X(GameplayCue_FireBlast, "GameplayCue.FireBlast", "FireBlast GameplayCue") \
+	\
+	/* Skills. To differentiate with the Attributes allocated to Characters. */ \
+	X(Skills_Attributes_CriticalHitChance, "Skills.Attributes.CriticalHitChance", "CriticalHitChance for Skills") \
+	X(Skills_Attributes_CriticalHitDamage, "Skills.Attributes.CriticalHitDamage", "CriticalHitDamage for Skills") \
+	X(Skills_Attributes_ArmorPenetration, "Skills.Attributes.ArmorPenetration", "ArmorPenetration for Skills") \
+	X(Skills_Attributes_KnockbackChance, "Skills.Attributes.KnockbackChance", "KnockbackChance for Skills") \
+	X(Skills_Attributes_KnockbackForceMagnitude, "Skills.Attributes.KnockbackForceMagnitude", "KnockbackForceMagnitude for Skills") \
+	X(Skills_Attributes_MaxProjectiles, "Skills.Attributes.MaxProjectiles", "MaxProjectiles for Skills") \
+	X(Skills_Attributes_MaxNumTargets, "Skills.Attributes.MaxNumTargets", "MaxNumTargets for Skills")
+
+// Dense index of every tag, in the order of AURA_GAMEPLAY_TAGS, for array indexed lookup tables.
+enum class EAuraGameplayTag : uint16
+{
+#define AURA_TAG_INDEX(Name, Tag, Comment) Name,
+	AURA_GAMEPLAY_TAGS(AURA_TAG_INDEX)
+#undef AURA_TAG_INDEX
+	Num
+};
+
+// Static native tags, registered with the tags manager when the module is loaded.
+namespace AuraGameplayTags
+{
+#define AURA_TAG_DECLARE(Name, Tag, Comment) UE_DECLARE_GAMEPLAY_TAG_EXTERN(Name)
+	AURA_GAMEPLAY_TAGS(AURA_TAG_DECLARE)
+#undef AURA_TAG_DECLARE
+}
 
 /**
  * AuraGameplayTags
@@ -17,127 +154,18 @@ public:
 	static const FAuraGameplayTags& Get() { return GameplayTags; }
 	static void InitializeNativeGameplayTags();
 
-	FGameplayTag Attributes_Primary_Strength;
-	FGameplayTag Attributes_Primary_Intelligence;
-	FGameplayTag Attributes_Primary_Resilience;
-	FGameplayTag Attributes_Primary_Vigor;
-
-	FGameplayTag Attributes_Secondary_Armor;
-	FGameplayTag Attributes_Secondary_ArmorPenetration;
-	FGameplayTag Attributes_Secondary_BlockChance;
-	FGameplayTag Attributes_Secondary_CriticalHitChance;
-	FGameplayTag Attributes_Secondary_CriticalHitDamage;
-	FGameplayTag Attributes_Secondary_CriticalHitResistance;
-	FGameplayTag Attributes_Secondary_HealthRegeneration;
-	FGameplayTag Attributes_Secondary_ManaRegeneration;
-	FGameplayTag Attributes_Secondary_MaxHealth;
-	FGameplayTag Attributes_Secondary_MaxMana;
-	FGameplayTag Attributes_Secondary_Health;
-	FGameplayTag Attributes_Secondary_Mana;
+	const FGameplayTag& GetTag(EAuraGameplayTag Tag) const { return this->*TagMembers[static_cast<int32>(Tag)]; }
 
-	FGameplayTag Attributes_Meta_IncomingXP;
-
-	FGameplayTag InputTag_LMB;
-	FGameplayTag InputTag_RMB;
-	FGameplayTag InputTag_1;
-	FGameplayTag InputTag_2;
-	FGameplayTag InputTag_3;
-	FGameplayTag InputTag_4;
-	FGameplayTag InputTag_Passive_1;
-	FGameplayTag InputTag_Passive_2;
-
-	FGameplayTag Damage;
-	FGameplayTag Damage_Fire;
-	FGameplayTag Damage_Lightning;
-	FGameplayTag Damage_Arcane;
-	FGameplayTag Damage_Physical;
-
-	FGameplayTag Attributes_Resistance_Fire;
-	FGameplayTag Attributes_Resistance_Lightning;
-	FGameplayTag Attributes_Resistance_Arcane;
-	FGameplayTag Attributes_Resistance_Physical;
+#define AURA_TAG_MEMBER(Name, Tag, Comment) FGameplayTag Name;
+	AURA_GAMEPLAY_TAGS(AURA_TAG_MEMBER)
+#undef AURA_TAG_MEMBER
 
 	TMap<FGameplayTag, FGameplayTag> DamageTypesToResistances;
-
-	FGameplayTag Debuff_Burn;
-	FGameplayTag Debuff_Stun;
-	FGameplayTag Debuff_Arcane;
-	FGameplayTag Debuff_Physical;
-
 	TMap<FGameplayTag, FGameplayTag> DamageTypesToDebuffs;
-
-	FGameplayTag Debuff_Chance;
-	FGameplayTag Debuff_Damage;
-	FGameplayTag Debuff_Frequency;
-	FGameplayTag Debuff_Duration;
-
-	FGameplayTag Abilities_None;
-	FGameplayTag Abilities_Attack;
-	FGameplayTag Abilities_Summon;
-	FGameplayTag Abilities_HitReact;
-	
-	FGameplayTag Abilities_Status_Locked;
-	FGameplayTag Abilities_Status_Eligible;
-	FGameplayTag Abilities_Status_Unlocked;
-	FGameplayTag Abilities_Status_Equipped;
-
-	FGameplayTag Abilities_Type_Offensive;
-	FGameplayTag Abilities_Type_Passive;
-	FGameplayTag Abilities_Type_None;
-	
-	FGameplayTag Abilities_Fire_Firebolt;
-	FGameplayTag Cooldown_Fire_Firebolt;
-
-	FGameplayTag Abilities_Fire_FireBlast;
-	FGameplayTag Cooldown_Fire_FireBlast;
-
-	FGameplayTag Abilities_Lightning_Electrocute;
-	FGameplayTag Cooldown_Lightning_Electrocute;
-
-	FGameplayTag Abilities_Lightning_LightningChain;
-	FGameplayTag Cooldown_Lightning_LightningChain;
-
-	FGameplayTag Abilities_Arcane_ArcaneShards;
-	FGameplayTag Cooldown_Arcane_ArcaneShards;
-
-	FGameplayTag Abilities_Fire_MeteorShower;
-	FGameplayTag Cooldown_Fire_MeteorShower;
-
-	FGameplayTag Abilities_Passive_HaloOfProtection;
-	FGameplayTag Abilities_Passive_LifeSiphon;
-	FGameplayTag Abilities_Passive_ManaSiphon;
-
-	FGameplayTag CombatSocket_Weapon;
-	FGameplayTag CombatSocket_RightHand;
-	FGameplayTag CombatSocket_LeftHand;
-	FGameplayTag CombatSocket_Tail;
-	
-	FGameplayTag Montage_Attack_1;
-	FGameplayTag Montage_Attack_2;
-	FGameplayTag Montage_Attack_3;
-	FGameplayTag Montage_Attack_4;
-	
-	FGameplayTag Effects_HitReact;
-
-	FGameplayTag Player_Block_InputPressed;
-	FGameplayTag Player_Block_InputHeld;
-	FGameplayTag Player_Block_InputReleased;
-	FGameplayTag Player_Block_CursorTrace;
-
-	FGameplayTag GameplayCue_FireBlast;
-
-	// SKILLS. To differentiate with the Attributes allocated to Characters.
-	FGameplayTag Skills_Attributes_CriticalHitChance;
-	FGameplayTag Skills_Attributes_CriticalHitDamage;
-	FGameplayTag Skills_Attributes_ArmorPenetration;
-	FGameplayTag Skills_Attributes_KnockbackChance;
-	FGameplayTag Skills_Attributes_KnockbackForceMagnitude;
-	FGameplayTag Skills_Attributes_MaxProjectiles;
-	FGameplayTag Skills_Attributes_MaxNumTargets;
-
 	
 protected:
 
 private:
 	static FAuraGameplayTags GameplayTags;
+	static FGameplayTag FAuraGameplayTags::* const TagMembers[static_cast<int32>(EAuraGameplayTag::Num)];
 };
@@ -0,0 +1,36 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI, BlueprintType)
+class UPoolableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors recycled by UAuraProjectilePoolSubsystem, to reset the state the pool does not know about
+ * (hit flags, looping sounds, niagara components...).
+ * Implementing it opts the class in the pool: the actor must then call UAuraProjectilePoolSubsystem::ReleaseProjectile
+ * instead of Destroy() when it hits and in its LifeSpanExpired override, and play its impact or expiry effects before.
+ * AAuraPooledProjectile does it for skill projectiles.
+ */
+class AURA_API IPoolableInterface
+{
+	GENERATED_BODY()
+
+	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
+public:
+	// Called when the actor leaves the pool, before it is configured and shown again.
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
+	void OnAcquiredFromPool();
+
+	// Called when the actor goes back to the pool instead of being destroyed.
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
+	void OnReleasedToPool();
+};
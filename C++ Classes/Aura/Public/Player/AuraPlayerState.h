@@ -26,6 +26,8 @@ class AURA_API AAuraPlayerState : public APlayerState, public IAbilitySystemInte
 public:
 	AAuraPlayerState();
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual void BeginPlay() override;
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 	UAttributeSet* GetAttributeSet() const { return AttributeSet; }
 
@@ -73,6 +75,17 @@ protected:
 	UPROPERTY(EditAnywhere)
 	TObjectPtr<UAttributeSet> AttributeSet;
 
+	// Properties are push based, the player state and its ability system are replicated at ActiveNetUpdateFrequency
+	// for ActiveNetUpdateSeconds after a change, then at IdleNetUpdateFrequency.
+	UPROPERTY(EditDefaultsOnly, Category="Replication")
+	float IdleNetUpdateFrequency = 10.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="Replication")
+	float ActiveNetUpdateFrequency = 100.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="Replication")
+	float ActiveNetUpdateSeconds = 1.f;
+
 private:
 	UPROPERTY(VisibleAnywhere, ReplicatedUsing=OnRep_Level)
 	int32 Level = 1;
@@ -86,6 +99,10 @@ private:
 	UPROPERTY(VisibleAnywhere, ReplicatedUsing=OnRep_SpellPoints)
 	int32 SpellPoints = 10;
 
+	// Server only, sends the change right away and raises the update rate.
+	void OnReplicatedStateChanged();
+	double LastReplicatedChangeTime = 0.0;
+
 	UFUNCTION()
 	void OnRep_Level(int32 OldLevel);
 
@@ -104,4 +121,7 @@ private:
 	
 	UFUNCTION()
 	void OnRep_Talents(TArray<FSkillTalent> OldTalents);
+
+	// Last values seen by the net profiler, to only record the properties that changed.
+	TMap<FName, TArray<uint8>> NetProfilerValues;
 };
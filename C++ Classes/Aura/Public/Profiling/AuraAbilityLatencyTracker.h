@@ -0,0 +1,65 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayPrediction.h"
+#include "GameplayTagContainer.h"
+
+class UAbilitySystemComponent;
+
+enum class EAuraAbilityLatency : uint8
+{
+	// Input press to activation on the machine of the player (predicted activation on clients).
+	Local,
+	// Input press to the server confirming the predicted activation, clients only.
+	RoundTrip,
+	// Activation to the first projectile spawned or beam traced, when both happen on the machine of the player.
+	FirstEffect,
+	Num
+};
+
+// Latency samples of one ability and one kind, bucketed in milliseconds.
+struct FAuraLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 13;
+	// Upper bound of every bucket but the last one, which gets everything above 1000ms.
+	static const float BucketUpperBoundsMs[NumBuckets - 1];
+
+	void AddSample(float LatencyMs);
+	// Upper bound of the bucket reaching Percentile (0-1), so an over estimate by at most a bucket.
+	float GetPercentileMs(float Percentile) const;
+
+	int32 Buckets[NumBuckets] = {};
+	int32 Count = 0;
+	double SumMs = 0.0;
+	float MinMs = 0.f;
+	float MaxMs = 0.f;
+};
+
+/**
+ * AuraAbilityLatencyTracker
+ *
+ * Timestamps of the ability path, from the input press to the first projectile or beam trace and the server confirmation,
+ * aggregated per ability tag. Last samples are shown by "stat AuraAbilityLatency", the histograms are written by
+ * Aura.AbilityLatency.DumpCsv. Enabled with Aura.AbilityLatency.Enabled 1, only activations that follow an input press
+ * on the same machine are tracked.
+ * Game thread only.
+ */
+struct AURA_API FAuraAbilityLatencyTracker
+{
+	static void MarkInputPressed(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag);
+	// ActivationPredictionKey is only used on clients, to be told when the server confirms the activation.
+	static void MarkActivated(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag, FPredictionKey ActivationPredictionKey);
+	// Only the first call after an activation is recorded.
+	static void MarkFirstEffect(const UAbilitySystemComponent* AbilitySystemComponent, const FGameplayTag& AbilityTag);
+
+	static void DumpCsv();
+	static void Reset();
+
+	// Callers check it before looking up the ability tag, so a disabled tracker costs nothing on the ability path.
+	static bool IsEnabled();
+
+private:
+	static void AddSample(const FGameplayTag& AbilityTag, EAuraAbilityLatency Kind, double Seconds);
+};
@@ -0,0 +1,60 @@
+// Copyright Nono Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/CoreNet.h"
+#include "AuraNetProfiler.generated.h"
+
+enum class EAuraNetTraffic : uint8
+{
+	// Parameters of an RPC, once per call.
+	Rpc,
+	// Value of a replicated property that changed, once per client connection.
+	Property,
+	// Field of a FAuraGameplayEffectContext, every time one is serialized for the network.
+	ContextField,
+	Num
+};
+
+/**
+ * Package map used to measure what is serialized. Objects are written as a fixed 32 bits placeholder, about the size
+ * of a NetGUID, so measuring never assigns nor exports the NetGUIDs of a real connection.
+ */
+UCLASS(Transient)
+class UAuraNetProfilerPackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override;
+};
+
+/**
+ * AuraNetProfiler
+ *
+ * Bytes and messages of our GAS traffic, per RPC, per replicated property and per effect context field, aggregated
+ * per second. Sizes are measured by serializing the values again, so bunch and packet headers are not counted. Recording is enabled
+ * with Aura.NetProfiler.Enabled 1 on the server, Aura.NetProfiler.DumpCsv writes Saved/Profiling/NetProfiler.
+ * Game thread only.
+ */
+struct AURA_API FAuraNetProfiler
+{
+	// Enabled and not already measuring, values measured by the profiler itself are never recorded.
+	static bool ShouldRecord();
+
+	// Parameters of an RPC of Actor (or one of its components) about to be sent, serialized by the net driver's rep layout.
+	static void RecordRpc(const AActor* Actor, UFunction* Function, void* Parameters);
+
+	// Records the properties of Actor whose serialized value changed since the last call. Arrays and structs without
+	// native NetSerialize are walked like the rep layout does, only their leaves are net serialized.
+	static void SampleProperties(const AActor* Actor, TConstArrayView<FName> PropertyNames, TMap<FName, TArray<uint8>>& InOutLastValues);
+
+	// Bits written by Serialize to a measuring archive.
+	static int64 MeasureBits(TFunctionRef<void(FArchive& Ar, UPackageMap* Map)> Serialize);
+
+	static void Record(EAuraNetTraffic Category, FName Name, int64 Bits, int32 Messages = 1);
+
+	static void DumpCsv();
+	static void Reset();
+};